@@ -0,0 +1,119 @@
+#include "arena.hpp"
+#include "source.hpp"
+#include <cstdlib>
+#include <new>
+
+/* round up so every node starts on a max_align_t boundary*/
+static size_t alignSize(size_t size)
+{
+    const size_t align = alignof(std::max_align_t);
+    return (size + align - 1) & ~(align - 1);
+}
+
+NodeArena::NodeArena(size_t chunkSize) : m_chunkSize(chunkSize),
+                                         m_chunks(),
+                                         m_cur(nullptr),
+                                         m_end(nullptr),
+                                         m_last(nullptr),
+                                         m_used(0),
+                                         m_nodes(0),
+                                         m_peak(0),
+                                         m_records() {}
+
+NodeArena::~NodeArena()
+{
+    for (auto &chunk : m_chunks)
+    {
+        std::free(chunk.data);
+    }
+    m_chunks.clear();
+}
+
+void NodeArena::newChunk(size_t minSize)
+{
+    size_t size = (minSize > m_chunkSize) ? minSize : m_chunkSize;
+    char *data = static_cast<char *>(std::malloc(size));
+    if (data == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    m_chunks.push_back({data, size});
+    m_cur = data;
+    m_end = data + size;
+}
+
+void *NodeArena::allocate(size_t size)
+{
+    size_t total = sizeof(Header) + alignSize(size);
+    if (m_cur == nullptr || static_cast<size_t>(m_end - m_cur) < total)
+    {
+        newChunk(total);
+    }
+    Header *header = reinterpret_cast<Header *>(m_cur);
+    header->prev = m_last;
+    header->alive = true;
+    m_last = header;
+    m_cur += total;
+    m_used += total;
+    m_nodes++;
+    return header + 1;
+}
+
+void NodeArena::release(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+    Header *header = static_cast<Header *>(ptr) - 1;
+    header->alive = false;
+}
+
+void NodeArena::reset(const string &name)
+{
+    /* destruct from the newest node to the oldest one, like the stack would*/
+    for (Header *header = m_last; header != nullptr; header = header->prev)
+    {
+        if (header->alive)
+        {
+            static_cast<Node *>(static_cast<void *>(header + 1))->~Node();
+        }
+    }
+    m_records.push_back({name, m_used, m_nodes});
+    if (m_used > m_peak)
+    {
+        m_peak = m_used;
+    }
+    /* keep the first chunk for the next function, release the rest*/
+    for (size_t i = 1; i < m_chunks.size(); i++)
+    {
+        std::free(m_chunks[i].data);
+    }
+    if (m_chunks.size() > 1)
+    {
+        m_chunks.resize(1);
+    }
+    if (m_chunks.empty())
+    {
+        m_cur = m_end = nullptr;
+    }
+    else
+    {
+        m_cur = m_chunks[0].data;
+        m_end = m_chunks[0].data + m_chunks[0].size;
+    }
+    m_last = nullptr;
+    m_used = 0;
+    m_nodes = 0;
+}
+
+void NodeArena::printStats(std::ostream &os) const
+{
+    size_t total = 0;
+    for (auto &record : m_records)
+    {
+        os << "[arena] " << (record.name.empty() ? "<global>" : record.name) << ": "
+           << record.bytes << " bytes in " << record.nodes << " nodes" << std::endl;
+        total += record.bytes;
+    }
+    os << "[arena] total: " << total << " bytes over " << m_records.size()
+       << " resets, peak " << m_peak << " bytes" << std::endl;
+}
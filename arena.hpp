@@ -0,0 +1,95 @@
+#ifndef COMPI_HW5_ARENA_H
+#define COMPI_HW5_ARENA_H
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <ostream>
+
+using std::string;
+using std::vector;
+
+/* FWD decl - the arena only owns objects of the Node hierarchy*/
+class Node;
+
+/**
+ * Bump allocator for the AST nodes created by the scanner and the parser.
+ * Every allocation is prefixed by a small header that chains it to the previous one,
+ * so reset() can run the destructors of the nodes that are still alive and then
+ * reuse the memory for the next function.
+ */
+class NodeArena
+{
+public:
+    static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    NodeArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /* Only releases the chunks - nodes alive at process exit are not destructed*/
+    ~NodeArena();
+
+    NodeArena(NodeArena const &) = delete;
+    void operator=(NodeArena const &) = delete;
+
+    /**
+     * Bump allocate size bytes for a new node.
+     * @param size the size of the object (as given to operator new)
+     * @return aligned memory that stays valid until the next reset()
+     */
+    void *allocate(size_t size);
+
+    /**
+     * Mark the node in ptr as already destructed (called from Node::operator delete),
+     * so reset() won't run its destructor a second time.
+     */
+    static void release(void *ptr);
+
+    /**
+     * Destruct every node that is still alive and rewind the arena.
+     * The bytes used since the last reset are recorded under the given name.
+     * @param name the name of the arena (usually the function that was just reduced)
+     */
+    void reset(const string &name = "");
+
+    /* number of bytes (including headers) allocated since the last reset*/
+    size_t bytesUsed() const { return m_used; }
+
+    /* print a line for each recorded reset and a summary*/
+    void printStats(std::ostream &os) const;
+
+private:
+    struct alignas(std::max_align_t) Header
+    {
+        Header *prev;
+        bool alive;
+    };
+
+    struct Chunk
+    {
+        char *data;
+        size_t size;
+    };
+
+    struct Record
+    {
+        string name;
+        size_t bytes;
+        size_t nodes;
+    };
+
+    /* allocate a new chunk that can hold at least minSize bytes*/
+    void newChunk(size_t minSize);
+
+    size_t m_chunkSize;
+    vector<Chunk> m_chunks;
+    /* bump pointer and end of the current chunk*/
+    char *m_cur;
+    char *m_end;
+    /* last allocation made, the headers form a list back to the first one*/
+    Header *m_last;
+    size_t m_used;
+    size_t m_nodes;
+    size_t m_peak;
+    vector<Record> m_records;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "batch.hpp"
+#include "compiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+/* the slowest files listed in the summary*/
+static const size_t SLOWEST_FILES = 5;
+
+struct FileResult
+{
+    bool ok;
+    /* the compilation error, or why the file couldn't be compiled*/
+    string error;
+    double seconds;
+};
+
+/* name.in -> name.ll (or name.bc), any other name gets the extension appended*/
+static string outputPath(const string &path, bool bitcode)
+{
+    const string extension = bitcode ? ".bc" : ".ll";
+    if (path.size() > 3 && path.compare(path.size() - 3, 3, ".in") == 0)
+    {
+        return path.substr(0, path.size() - 3) + extension;
+    }
+    return path + extension;
+}
+
+static FileResult compileFile(const string &path, const BatchOptions &options)
+{
+    FileResult result = {false, "", 0};
+    Clock::time_point start = Clock::now();
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        result.error = "cannot open " + path;
+        return result;
+    }
+    std::ostringstream source;
+    source << in.rdbuf();
+    string output = outputPath(path, options.bitcode);
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        result.error = "cannot open " + output;
+        return result;
+    }
+
+    CompilerContext context;
+    CodeBuffer &buffer = context.buffer;
+    if (options.ssa)
+    {
+        buffer.enableSSA();
+    }
+#ifdef HW5_LLVM
+    if (options.llvmBackend)
+    {
+        buffer.enableLLVMBackend(options.optLevel, options.bitcode);
+    }
+#endif
+    buffer.setOutput(out);
+    try
+    {
+        buffer.emitGlobals();
+        if (options.stream)
+        {
+            buffer.startStreaming();
+        }
+        if (context.parse(source.str()))
+        {
+            buffer.printGlobalBuffer();
+            buffer.printCodeBuffer();
+            result.ok = true;
+        }
+        else
+        {
+            /* after the code streamed before it, as on stdout*/
+            out << context.error().message << std::endl;
+            result.error = context.error().message;
+        }
+    }
+    catch (const CompileError &error)
+    {
+        /* an error of the LLVM backend, it only fails this file*/
+        result.error = error.message;
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+size_t compileBatch(const vector<string> &files, unsigned jobs, const BatchOptions &options, std::ostream &summary)
+{
+    Clock::time_point start = Clock::now();
+    vector<FileResult> results(files.size());
+    /* the workers take the files in order, one at a time, so a slow file doesn't hold back a whole share*/
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < files.size(); i = next++)
+        {
+            results[i] = compileFile(files[i], options);
+        }
+    };
+    jobs = std::max(1u, std::min<unsigned>(jobs, files.size()));
+    vector<std::thread> workers;
+    for (unsigned i = 1; i < jobs; i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : workers)
+    {
+        thread.join();
+    }
+    double wall = std::chrono::duration<double>(Clock::now() - start).count();
+
+    size_t failed = 0;
+    double total = 0;
+    vector<size_t> order;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        if (!results[i].ok)
+        {
+            summary << "[batch] " << files[i] << ": " << results[i].error << std::endl;
+            failed++;
+        }
+        total += results[i].seconds;
+        order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return results[a].seconds > results[b].seconds; });
+    summary << "[batch] " << files.size() << " files, " << failed << " failed, " << jobs << " jobs in "
+            << wall * 1000 << " ms (" << total * 1000 << " ms of compilation, "
+            << (files.empty() ? 0 : total / files.size() * 1000) << " ms per file)" << std::endl;
+    for (size_t i = 0; i < order.size() && i < SLOWEST_FILES; i++)
+    {
+        summary << "[batch]   " << files[order[i]] << " " << results[order[i]].seconds * 1000 << " ms" << std::endl;
+    }
+    return failed;
+}
@@ -0,0 +1,30 @@
+#ifndef COMPI_HW5_BATCH_H
+#define COMPI_HW5_BATCH_H
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <ostream>
+
+using std::string;
+using std::vector;
+
+/* what every file of a batch is compiled with (the matching hw5 flags)*/
+struct BatchOptions
+{
+    bool ssa;
+    bool stream;
+    bool llvmBackend;
+    int optLevel;
+    bool bitcode;
+};
+
+/**
+ * Compile each of the files with its own CompilerContext, on a pool of jobs worker threads.
+ * The output of "name.in" is written to "name.ll" ("name.bc" with bitcode), exactly what hw5
+ * would print for it - the code, or the compilation error.
+ * The failures and a summary of the compile times are printed to summary.
+ * @return the number of files that failed
+ */
+size_t compileBatch(const vector<string> &files, unsigned jobs, const BatchOptions &options, std::ostream &summary);
+
+#endif
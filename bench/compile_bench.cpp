@@ -0,0 +1,309 @@
+/**
+ * Measures the compiler's own speed: runs hw5 --stats over each file a few times and reports
+ * the median total time, the tokens and lines per second, the time of each phase (from the
+ * [time] line) and the peak RSS. The results can be saved as CSV, and compared with a saved
+ * baseline: a file whose time or peak memory grew by more than the threshold is a regression.
+ * usage: compile_bench [--hw5 path] [--runs n] [--csv results.csv] [--baseline baseline.csv]
+ *                      [--threshold percent] [-- hw5 args --] file...
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+struct Result
+{
+    string name;
+    size_t lines;
+    size_t tokens;
+    /* medians of the runs, in ms*/
+    double totalMs;
+    double preludeMs;
+    double parseMs;
+    double emitMs;
+    long peakKB;
+};
+
+/* count the lines and the tokens as scanner.lex splits them (close enough for a rate)*/
+static void countTokens(const string &source, size_t &lines, size_t &tokens)
+{
+    lines = count(source.begin(), source.end(), '\n');
+    tokens = 0;
+    for (size_t i = 0; i < source.size();)
+    {
+        char c = source[i];
+        if (isspace((unsigned char)c))
+        {
+            i++;
+        }
+        else if (c == '/' && i + 1 < source.size() && source[i + 1] == '/')
+        {
+            i = source.find('\n', i);
+            i = (i == string::npos) ? source.size() : i;
+        }
+        else
+        {
+            tokens++;
+            if (isalnum((unsigned char)c))
+            {
+                while (i < source.size() && isalnum((unsigned char)source[i]))
+                    i++;
+            }
+            else if (c == '"')
+            {
+                for (i++; i < source.size() && source[i] != '"'; i++)
+                    i += (source[i] == '\\');
+                i++;
+            }
+            else
+            {
+                /* ==, !=, <= and >= are a single token*/
+                i += (i + 1 < source.size() && source[i + 1] == '=' && strchr("=!<>", c) != nullptr) ? 2 : 1;
+            }
+        }
+    }
+}
+
+/* run hw5 < path with the stats written to statsPath, return the peak RSS in KB (-1 on failure)*/
+static long runCompiler(const vector<string> &argv, const string &path, const string &statsPath)
+{
+    vector<char *> args;
+    for (const string &arg : argv)
+    {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        int inFd = open(path.c_str(), O_RDONLY);
+        int outFd = open("/dev/null", O_WRONLY);
+        int errFd = open(statsPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (inFd < 0 || outFd < 0 || errFd < 0)
+        {
+            _exit(127);
+        }
+        dup2(inFd, STDIN_FILENO);
+        dup2(outFd, STDOUT_FILENO);
+        dup2(errFd, STDERR_FILENO);
+        execvp(args[0], args.data());
+        _exit(127);
+    }
+    int status = 0;
+    struct rusage usage = {};
+    wait4(pid, &status, 0, &usage);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        return -1;
+    }
+    return usage.ru_maxrss;
+}
+
+/* the [time] line: prelude X ms, parse and codegen Y ms, emit Z ms, total W ms*/
+static bool readPhases(const string &statsPath, double phases[4])
+{
+    ifstream stats(statsPath);
+    string line;
+    while (getline(stats, line))
+    {
+        if (line.compare(0, 7, "[time] ") == 0)
+        {
+            return sscanf(line.c_str(), "[time] prelude %lf ms, parse and codegen %lf ms, emit %lf ms, total %lf ms",
+                          &phases[0], &phases[1], &phases[2], &phases[3]) == 4;
+        }
+    }
+    return false;
+}
+
+static double median(vector<double> values)
+{
+    sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+static bool benchmark(const string &path, const vector<string> &argv, int runs, const string &statsPath, Result &result)
+{
+    ifstream file(path);
+    if (!file)
+    {
+        cerr << "cannot open " << path << endl;
+        return false;
+    }
+    ostringstream source;
+    source << file.rdbuf();
+    result.name = path.substr(path.find_last_of('/') + 1);
+    countTokens(source.str(), result.lines, result.tokens);
+
+    vector<double> samples[4];
+    vector<double> peaks;
+    for (int run = 0; run < runs; run++)
+    {
+        double phases[4];
+        long peak = runCompiler(argv, path, statsPath);
+        if (peak < 0 || !readPhases(statsPath, phases))
+        {
+            cerr << "hw5 failed on " << path << " (it has to compile, and to print the [time] line of --stats)" << endl;
+            return false;
+        }
+        for (int i = 0; i < 4; i++)
+            samples[i].push_back(phases[i]);
+        peaks.push_back(peak);
+    }
+    result.preludeMs = median(samples[0]);
+    result.parseMs = median(samples[1]);
+    result.emitMs = median(samples[2]);
+    result.totalMs = median(samples[3]);
+    result.peakKB = static_cast<long>(median(peaks));
+    return true;
+}
+
+static const char *CSV_HEADER = "name,lines,tokens,total_ms,prelude_ms,parse_ms,emit_ms,peak_kb";
+
+static void writeCsv(ostream &os, const vector<Result> &results)
+{
+    os << CSV_HEADER << "\n";
+    for (const Result &r : results)
+    {
+        os << r.name << "," << r.lines << "," << r.tokens << "," << r.totalMs << "," << r.preludeMs << ","
+           << r.parseMs << "," << r.emitMs << "," << r.peakKB << "\n";
+    }
+}
+
+static bool readCsv(const string &path, map<string, Result> &results)
+{
+    ifstream csv(path);
+    string line;
+    if (!getline(csv, line) || line != CSV_HEADER)
+    {
+        cerr << "cannot read the baseline " << path << endl;
+        return false;
+    }
+    while (getline(csv, line))
+    {
+        Result r;
+        char name[256];
+        if (sscanf(line.c_str(), "%255[^,],%zu,%zu,%lf,%lf,%lf,%lf,%ld", name, &r.lines, &r.tokens, &r.totalMs,
+                   &r.preludeMs, &r.parseMs, &r.emitMs, &r.peakKB) == 8)
+        {
+            r.name = name;
+            results[r.name] = r;
+        }
+    }
+    return true;
+}
+
+static double change(double now, double before)
+{
+    return before > 0 ? (now - before) / before * 100 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    string hw5 = "./hw5";
+    int runs = 5;
+    string csvPath, baselinePath;
+    double threshold = 10;
+    vector<string> hw5Args;
+    vector<string> files;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--hw5" && i + 1 < argc)
+            hw5 = argv[++i];
+        else if (arg == "--runs" && i + 1 < argc)
+            runs = max(1, atoi(argv[++i]));
+        else if (arg == "--csv" && i + 1 < argc)
+            csvPath = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc)
+            threshold = atof(argv[++i]);
+        else if (arg == "--")
+            for (i++; i < argc && strcmp(argv[i], "--") != 0; i++)
+                hw5Args.push_back(argv[i]);
+        else
+            files.push_back(arg);
+    }
+    if (files.empty())
+    {
+        cerr << "usage: compile_bench [--hw5 path] [--runs n] [--csv results.csv] [--baseline baseline.csv] "
+                "[--threshold percent] [-- hw5 args --] file..."
+             << endl;
+        return 1;
+    }
+    map<string, Result> baseline;
+    if (!baselinePath.empty() && !readCsv(baselinePath, baseline))
+    {
+        return 1;
+    }
+
+    vector<string> command = {hw5, "--stats"};
+    command.insert(command.end(), hw5Args.begin(), hw5Args.end());
+    char statsPath[] = "/tmp/compile_bench_XXXXXX";
+    int statsFd = mkstemp(statsPath);
+    if (statsFd < 0)
+    {
+        cerr << "cannot create a temporary file" << endl;
+        return 1;
+    }
+    close(statsFd);
+
+    vector<Result> results;
+    int regressions = 0;
+    cout << left << setw(16) << "file" << right << setw(8) << "lines" << setw(9) << "tokens" << setw(11) << "total ms"
+         << setw(12) << "tokens/s" << setw(11) << "lines/s" << setw(10) << "parse ms" << setw(9) << "emit ms"
+         << setw(10) << "peak KB" << endl;
+    cout << fixed << setprecision(2);
+    for (const string &file : files)
+    {
+        Result r;
+        if (!benchmark(file, command, runs, statsPath, r))
+        {
+            unlink(statsPath);
+            return 1;
+        }
+        results.push_back(r);
+        double seconds = r.totalMs / 1000;
+        cout << left << setw(16) << r.name << right << setw(8) << r.lines << setw(9) << r.tokens << setw(11)
+             << r.totalMs << setw(12) << setprecision(0) << r.tokens / seconds << setw(11) << r.lines / seconds
+             << setprecision(2) << setw(10) << r.parseMs << setw(9) << r.emitMs << setw(10) << r.peakKB << endl;
+
+        map<string, Result>::const_iterator before = baseline.find(r.name);
+        if (before != baseline.end())
+        {
+            double time = change(r.totalMs, before->second.totalMs);
+            double memory = change(r.peakKB, before->second.peakKB);
+            bool regressed = time > threshold || memory > threshold;
+            regressions += regressed;
+            cout << "    vs baseline: time " << showpos << time << "%, parse " << change(r.parseMs, before->second.parseMs)
+                 << "%, emit " << change(r.emitMs, before->second.emitMs) << "%, peak memory " << memory << "%"
+                 << noshowpos << (regressed ? "  REGRESSION" : "") << endl;
+        }
+    }
+    unlink(statsPath);
+
+    if (!csvPath.empty())
+    {
+        ofstream csv(csvPath);
+        writeCsv(csv, results);
+    }
+    if (!baseline.empty())
+    {
+        cout << regressions << " regressions (more than " << threshold << "% slower or bigger than the baseline)" << endl;
+    }
+    return regressions == 0 ? 0 : 1;
+}
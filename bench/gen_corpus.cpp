@@ -0,0 +1,233 @@
+/**
+ * Writes a deterministic corpus of FanC programs for compile_bench, one file per shape:
+ *   functions - many small functions calling each other (symbol table and per-function work)
+ *   nesting   - deeply nested blocks, ifs and whiles (scopes and the parser stack)
+ *   boolchain - long and/or/not chains in the conditions (backpatching lists)
+ *   overloads - hundreds of override overloads of the same name (overload resolution)
+ *   math      - huge arithmetic and relational expressions, like t24-stress-math.in
+ * Every program compiles and runs without errors. The same scale always gives the same files.
+ * usage: gen_corpus <output dir> [scale (default 1)]
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* a fixed generator (std distributions differ between libraries), seeded per shape*/
+class Random
+{
+public:
+    Random(unsigned long long seed) : m_state(seed * 6364136223846793005ULL + 1442695040888963407ULL) {}
+
+    /* uniform in [0, bound)*/
+    int next(int bound)
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return static_cast<int>(m_state % static_cast<unsigned long long>(bound));
+    }
+
+private:
+    unsigned long long m_state;
+};
+
+static const char *RELOPS[] = {"==", "!=", "<", ">", "<=", ">="};
+
+/* an int expression of the given depth over the variables v0..v<vars-1>, never divides by zero*/
+static string intExp(Random &random, int depth, int vars)
+{
+    if (depth == 0 || random.next(4) == 0)
+    {
+        if (vars > 0 && random.next(2) == 0)
+            return "v" + to_string(random.next(vars));
+        /* byte literals mix in the byte to int conversions*/
+        return to_string(random.next(100)) + (random.next(3) == 0 ? " b" : "");
+    }
+    switch (random.next(4))
+    {
+    case 0:
+        return "(" + intExp(random, depth - 1, vars) + " + " + intExp(random, depth - 1, vars) + ")";
+    case 1:
+        return "(" + intExp(random, depth - 1, vars) + " - " + intExp(random, depth - 1, vars) + ")";
+    case 2:
+        return "(" + intExp(random, depth - 1, vars) + " * " + intExp(random, depth - 1, vars) + ")";
+    default:
+        return "(" + intExp(random, depth - 1, vars) + " / " + to_string(1 + random.next(99)) + ")";
+    }
+}
+
+/* a chain of length comparisons joined with and / or, some of them negated*/
+static string boolChain(Random &random, int length, int vars)
+{
+    string chain;
+    for (int i = 0; i < length; i++)
+    {
+        if (i > 0)
+            chain += random.next(2) ? " and " : " or ";
+        string compare = "(" + intExp(random, 1, vars) + " " + RELOPS[random.next(6)] + " " + intExp(random, 1, vars) + ")";
+        chain += random.next(4) == 0 ? "(not " + compare + ")" : compare;
+    }
+    return chain;
+}
+
+static void functions(ostream &os, int count)
+{
+    Random random(1);
+    os << "int f0(int x, int y) {\n    return x + y;\n}\n";
+    for (int i = 1; i < count; i++)
+    {
+        os << "int f" << i << "(int x, int y) {\n"
+           << "    int v0 = x + " << random.next(100) << ";\n"
+           << "    int v1 = " << intExp(random, 2, 1) << ";\n"
+           << "    if (v0 > y) {\n        v1 = v1 - y;\n    }\n"
+           << "    return f" << random.next(i) << "(v1, x);\n}\n";
+    }
+    os << "void main() {\n    printi(f" << count - 1 << "(1, 2));\n}\n";
+}
+
+static void nesting(ostream &os, int depth)
+{
+    Random random(2);
+    os << "void main() {\n    int v0 = 0;\n";
+    for (int i = 1; i <= depth; i++)
+    {
+        string indent(4 * i, ' ');
+        switch (random.next(3))
+        {
+        case 0:
+            os << indent << "{\n";
+            break;
+        case 1:
+            os << indent << "if (v0 >= " << random.next(10) << ") {\n";
+            break;
+        default:
+            /* runs once*/
+            os << indent << "while (v0 < " << i << ") {\n" << indent << "    v0 = " << i << ";\n";
+            break;
+        }
+        os << indent << "    int v" << i << " = v" << i - 1 << " + " << random.next(10) << ";\n";
+    }
+    os << string(4 * depth + 4, ' ') << "printi(v" << depth << ");\n";
+    for (int i = depth; i >= 1; i--)
+    {
+        os << string(4 * i, ' ') << "}\n";
+    }
+    os << "}\n";
+}
+
+static void boolchain(ostream &os, int statements, int length)
+{
+    Random random(3);
+    os << "void main() {\n";
+    for (int i = 0; i < 8; i++)
+    {
+        os << "    int v" << i << " = " << random.next(100) << ";\n";
+    }
+    for (int i = 0; i < statements; i++)
+    {
+        os << "    if (" << boolChain(random, length, 8) << ")\n        v" << random.next(8) << " = v" << random.next(8)
+           << " + 1;\n    else\n        v" << random.next(8) << " = " << random.next(100) << ";\n";
+        os << "    bool c" << i << " = " << boolChain(random, length, 8) << ";\n";
+    }
+    os << "    printi(v0);\n}\n";
+}
+
+static void overloads(ostream &os, int count)
+{
+    /* the signatures over int and bool, shortest first - a byte argument could match an int
+       parameter too, the calls pass exactly the parameter types so none of them is ambiguous*/
+    vector<vector<bool>> signatures;
+    for (int arity = 1; (int)signatures.size() < count; arity++)
+    {
+        for (int bits = 0; bits < (1 << arity) && (int)signatures.size() < count; bits++)
+        {
+            vector<bool> isInt;
+            for (int i = 0; i < arity; i++)
+                isInt.push_back((bits >> i) & 1);
+            signatures.push_back(isInt);
+        }
+    }
+    for (const vector<bool> &signature : signatures)
+    {
+        os << "override int ov(";
+        for (size_t i = 0; i < signature.size(); i++)
+            os << (i ? ", " : "") << (signature[i] ? "int p" : "bool p") << i;
+        os << ") {\n    int s = " << signature.size() << ";\n";
+        for (size_t i = 0; i < signature.size(); i++)
+            os << (signature[i] ? "    s = s + p" + to_string(i) + ";\n" : "    if (p" + to_string(i) + ") s = s * 2;\n");
+        os << "    return s;\n}\n";
+    }
+    os << "void main() {\n    int total = 0;\n";
+    for (const vector<bool> &signature : signatures)
+    {
+        os << "    total = total + ov(";
+        for (size_t i = 0; i < signature.size(); i++)
+            os << (i ? ", " : "") << (signature[i] ? to_string(i) : (i % 2 ? "true" : "false"));
+        os << ");\n";
+    }
+    os << "    printi(total);\n}\n";
+}
+
+static void math(ostream &os, int statements, int depth)
+{
+    Random random(5);
+    os << "void main() {\n";
+    for (int i = 0; i < statements; i++)
+    {
+        if (i % 2 == 0)
+            os << "    int v" << i / 2 << " = " << intExp(random, depth, i / 2) << ";\n";
+        else
+            os << "    bool c" << i / 2 << " = " << boolChain(random, depth, i / 2) << ";\n";
+    }
+    os << "    printi(v0);\n}\n";
+}
+
+static bool write(const string &path, const string &program)
+{
+    ofstream file(path);
+    file << program;
+    if (!file)
+    {
+        cerr << "cannot write " << path << endl;
+        return false;
+    }
+    cout << path << endl;
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: gen_corpus <output dir> [scale]" << endl;
+        return 1;
+    }
+    string dir = argv[1];
+    int scale = (argc > 2) ? atoi(argv[2]) : 1;
+    if (scale < 1)
+        scale = 1;
+
+    ostringstream program;
+    bool ok = true;
+    functions(program, 2000 * scale);
+    ok = ok && write(dir + "/functions.in", program.str());
+    program.str("");
+    /* bison's stack is limited (YYMAXDEPTH), the depth doesn't grow with the scale*/
+    nesting(program, 400);
+    ok = ok && write(dir + "/nesting.in", program.str());
+    program.str("");
+    boolchain(program, 200 * scale, 40);
+    ok = ok && write(dir + "/boolchain.in", program.str());
+    program.str("");
+    overloads(program, 300 * scale);
+    ok = ok && write(dir + "/overloads.in", program.str());
+    program.str("");
+    math(program, 600 * scale, 6);
+    ok = ok && write(dir + "/math.in", program.str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+/**
+ * Measures how fast the code hw5 generates runs: each program is compiled with hw5, then
+ *   lli    - run by lli (JIT compiled, the time includes the JIT)
+ *   native - compiled with llc -O2, linked with cc and run
+ * The median execution time and the user space instructions retired (from a hardware counter,
+ * "-" where the kernel doesn't allow it) of the runs are reported, and the outputs of the two
+ * have to be the same. Compare the results before and after a change to the code generation.
+ * usage: runtime_bench [--hw5 path] [--lli path] [--llc path] [--cc path] [--runs n]
+ *                      [--csv results.csv] [-- hw5 args --] file...
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <linux/perf_event.h>
+#include <sstream>
+#include <string>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+struct Run
+{
+    /* the exit code, -1 if it didn't exit (or couldn't be run)*/
+    int status;
+    double seconds;
+    /* -1 when the counter isn't available*/
+    long long instructions;
+};
+
+struct Measure
+{
+    double ms;
+    long long instructions;
+};
+
+struct Result
+{
+    string name;
+    Measure lli;
+    Measure native;
+    bool sameOutput;
+};
+
+/* count the instructions pid retires in user space once it calls exec, -1 if it can't be counted*/
+static int openInstructionCounter(pid_t pid)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.enable_on_exec = 1;
+    /* lli runs the program on its own threads*/
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, pid, -1, -1, 0));
+}
+
+/**
+ * Run argv with stdin and stdout redirected to the given files. The child waits on a pipe
+ * until the counter is attached to it, so the count starts at its exec.
+ */
+static Run run(const vector<string> &argv, const string &in, const string &out)
+{
+    Run result = {-1, 0, -1};
+    vector<char *> args;
+    for (const string &arg : argv)
+    {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+    int go[2];
+    if (pipe(go) != 0)
+    {
+        return result;
+    }
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        char c;
+        close(go[1]);
+        if (read(go[0], &c, 1) != 1)
+            _exit(127);
+        int inFd = open(in.c_str(), O_RDONLY);
+        int outFd = open(out.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (inFd < 0 || outFd < 0)
+            _exit(127);
+        dup2(inFd, STDIN_FILENO);
+        dup2(outFd, STDOUT_FILENO);
+        execvp(args[0], args.data());
+        _exit(127);
+    }
+    close(go[0]);
+    int counter = openInstructionCounter(pid);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    if (write(go[1], "x", 1) != 1)
+    {
+        kill(pid, SIGKILL);
+    }
+    close(go[1]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (WIFEXITED(status) && WEXITSTATUS(status) != 127)
+    {
+        result.status = WEXITSTATUS(status);
+    }
+    if (counter >= 0)
+    {
+        long long count = 0;
+        if (read(counter, &count, sizeof(count)) == sizeof(count))
+            result.instructions = count;
+        close(counter);
+    }
+    return result;
+}
+
+/* the median time and instruction count of the runs*/
+static bool measure(const vector<string> &argv, const string &in, const string &out, int runs, Measure &measure)
+{
+    vector<double> times;
+    vector<long long> counts;
+    for (int i = 0; i < runs; i++)
+    {
+        /* the exit code of a void main() is garbage, it only has to exit*/
+        Run r = run(argv, in, out);
+        if (r.status < 0)
+            return false;
+        times.push_back(r.seconds * 1000);
+        counts.push_back(r.instructions);
+    }
+    sort(times.begin(), times.end());
+    sort(counts.begin(), counts.end());
+    measure.ms = times[times.size() / 2];
+    measure.instructions = counts[counts.size() / 2];
+    return true;
+}
+
+static string readFile(const string &path)
+{
+    ifstream file(path, ios::binary);
+    ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+static string instructions(long long count)
+{
+    return count < 0 ? "-" : to_string(count);
+}
+
+int main(int argc, char *argv[])
+{
+    string hw5 = "./hw5", lli = "lli", llc = "llc", cc = "cc";
+    int runs = 3;
+    string csvPath;
+    vector<string> hw5Args;
+    vector<string> files;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--hw5" && i + 1 < argc)
+            hw5 = argv[++i];
+        else if (arg == "--lli" && i + 1 < argc)
+            lli = argv[++i];
+        else if (arg == "--llc" && i + 1 < argc)
+            llc = argv[++i];
+        else if (arg == "--cc" && i + 1 < argc)
+            cc = argv[++i];
+        else if (arg == "--runs" && i + 1 < argc)
+            runs = max(1, atoi(argv[++i]));
+        else if (arg == "--csv" && i + 1 < argc)
+            csvPath = argv[++i];
+        else if (arg == "--")
+            for (i++; i < argc && strcmp(argv[i], "--") != 0; i++)
+                hw5Args.push_back(argv[i]);
+        else
+            files.push_back(arg);
+    }
+    if (files.empty())
+    {
+        cerr << "usage: runtime_bench [--hw5 path] [--lli path] [--llc path] [--cc path] [--runs n] "
+                "[--csv results.csv] [-- hw5 args --] file..."
+             << endl;
+        return 1;
+    }
+    char dirTemplate[] = "/tmp/runtime_bench_XXXXXX";
+    if (mkdtemp(dirTemplate) == nullptr)
+    {
+        cerr << "cannot create a temporary directory" << endl;
+        return 1;
+    }
+    string dir = dirTemplate;
+    string ll = dir + "/program.ll", object = dir + "/program.o", binary = dir + "/program";
+    string lliOut = dir + "/lli.out", nativeOut = dir + "/native.out", log = dir + "/log";
+
+    vector<string> compile = {hw5};
+    compile.insert(compile.end(), hw5Args.begin(), hw5Args.end());
+    vector<Result> results;
+    bool failed = false;
+    cout << left << setw(16) << "program" << right << setw(11) << "lli ms" << setw(16) << "lli instr" << setw(11)
+         << "native ms" << setw(16) << "native instr" << endl;
+    cout << fixed << setprecision(2);
+    for (const string &file : files)
+    {
+        Result r;
+        r.name = file.substr(file.find_last_of('/') + 1);
+        /* hw5 exits with 1 on a compilation error. llc and cc read their input from the arguments*/
+        bool ok = run(compile, file, ll).status == 0;
+        ok = ok && run({llc, "-O2", "-relocation-model=pic", "-filetype=obj", ll, "-o", object}, "/dev/null", log).status == 0;
+        ok = ok && run({cc, object, "-o", binary}, "/dev/null", log).status == 0;
+        ok = ok && measure({lli, ll}, "/dev/null", lliOut, runs, r.lli);
+        ok = ok && measure({binary}, "/dev/null", nativeOut, runs, r.native);
+        if (!ok)
+        {
+            cerr << "cannot compile or run " << file << endl;
+            failed = true;
+            continue;
+        }
+        r.sameOutput = readFile(lliOut) == readFile(nativeOut);
+        failed = failed || !r.sameOutput;
+        results.push_back(r);
+        cout << left << setw(16) << r.name << right << setw(11) << r.lli.ms << setw(16) << instructions(r.lli.instructions)
+             << setw(11) << r.native.ms << setw(16) << instructions(r.native.instructions)
+             << (r.sameOutput ? "" : "  OUTPUTS DIFFER") << endl;
+    }
+    for (const string &path : {ll, object, binary, lliOut, nativeOut, log})
+    {
+        unlink(path.c_str());
+    }
+    rmdir(dir.c_str());
+
+    if (!csvPath.empty())
+    {
+        ofstream csv(csvPath);
+        csv << "name,lli_ms,lli_instructions,native_ms,native_instructions,same_output\n";
+        for (const Result &r : results)
+        {
+            csv << r.name << "," << r.lli.ms << "," << r.lli.instructions << "," << r.native.ms << ","
+                << r.native.instructions << "," << (r.sameOutput ? 1 : 0) << "\n";
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Compares the throughput of the ways the generated code can be written:
+ *   endl   - a line at a time with std::endl (what printCodeBuffer used to do)
+ *   sink   - through an OutputSink
+ *   thread - through an OutputSink with the background writer thread
+ * usage: sink_bench [output file (default /dev/null)] [megabytes (default 64)]
+ */
+#include "output_sink.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/* lines that look like what the code generator prints*/
+static const char *LINES[] = {
+    "%var_1234 = getelementptr i32, i32* %var_17, i32 3",
+    "%var_1235 = load i32, i32* %var_1234",
+    "%var_1236 = add i32 %var_1235, 1",
+    "store i32 %var_1236, i32* %var_1234",
+    "br i1 %var_1237, label %label_42, label %label_43",
+    "label_42:",
+    "call void @print_0(i8* %var_1238)",
+};
+static const int LINES_COUNT = sizeof(LINES) / sizeof(LINES[0]);
+
+/* write about 'bytes' bytes of lines to os, return the exact number of bytes*/
+static size_t writeLines(ostream &os, size_t bytes, bool use_endl)
+{
+    size_t written = 0;
+    for (int i = 0; written < bytes; i = (i + 1) % LINES_COUNT)
+    {
+        string line = LINES[i];
+        if (use_endl)
+            os << line << endl;
+        else
+            os << line << '\n';
+        written += line.size() + 1;
+    }
+    return written;
+}
+
+static void report(const char *name, size_t bytes, chrono::steady_clock::time_point start)
+{
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << name << ": " << bytes << " bytes in " << seconds << " s, "
+         << (bytes / seconds) / (1024 * 1024) << " MB/s" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : "/dev/null";
+    size_t bytes = ((argc > 2) ? atol(argv[2]) : 64) * 1024 * 1024;
+
+    {
+        ofstream file(path);
+        if (!file)
+        {
+            cerr << "cannot open " << path << endl;
+            return 1;
+        }
+        auto start = chrono::steady_clock::now();
+        size_t written = writeLines(file, bytes, true);
+        report("endl", written, start);
+    }
+
+    for (int background = 0; background < 2; background++)
+    {
+        auto start = chrono::steady_clock::now();
+        size_t written;
+        {
+            OutputSink sink;
+            if (!sink.open(path))
+            {
+                cerr << "cannot open " << path << endl;
+                return 1;
+            }
+            if (background)
+                sink.startWriter();
+            ostream os(&sink);
+            written = writeLines(os, bytes, false);
+        }
+        report(background ? "thread" : "sink", written, start);
+    }
+    return 0;
+}
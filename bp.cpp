@@ -1,18 +1,26 @@
 #include "bp.hpp"
+#include "ssa.hpp"
+#ifdef HW5_LLVM
+#include "llvm_backend.hpp"
+#endif
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
 using namespace std;
 
-bool replace(string &str, const string &from, const string &to, const BranchLabelIndex index);
-
-CodeBuffer::CodeBuffer() : buffer(), globalDefs(), regCounter(0) {}
+CodeBuffer::CodeBuffer() : buffer(), extraOperands(), globalDefs(), callees(), calleeIndex(),
+                           regCounter(0), labelCounter(0), functionStart(0), frameSlots(),
+                           frameBytes(0), functionsCount(0), divisionError(NO_LABEL), checkedDivisors(),
+                           sourceOf(), divisionChecks(0), elidedDivisionChecks(0), slotStates(),
+                           forwardedLoads(0), deadStores(0), strings(), stringIndex(),
+                           stringUses(0), stringBytes(0), streaming(false),
+                           flushedInstructions(0), ssaBuilder(nullptr), llvmBackend(nullptr), peakInstructions(0), out(&cout) {}
 
 void CodeBuffer::emitGlobals()
 {
     /** @todo: make sure relative path is working */
-    string path = 
+    string path =
     "print_functions.llvm";
     // "/home/aviv.m/Compilation/LLVMCodeGeneration/print_functions.llvm";
     // string path = "/home/nitai.kluger/LLVMCodeGeneration/print_functions.llvm";
@@ -20,51 +28,88 @@ void CodeBuffer::emitGlobals()
     this->emitFile(path);
 }
 
-/**
- * With the Singleton design pattern, the single instance of CodeBuffer could be accessed using:
- * CodeBuffer &buffer = CodeBuffer::instance();
- */
-CodeBuffer &CodeBuffer::instance()
+CodeBuffer::~CodeBuffer()
 {
-    static CodeBuffer inst; // Only instance
-    return inst;
+    delete ssaBuilder;
+#ifdef HW5_LLVM
+    delete llvmBackend;
+#endif
 }
+
 /**
  * generates a jump location label for the next command, writes it to the buffer and returns it
  */
-string CodeBuffer::genLabel()
+LabelId CodeBuffer::genLabel()
 {
-    std::stringstream label;
-    label << "label_";
-    label << buffer.size();
-    std::string ret(label.str());
+    LabelId label = labelCounter++;
 
-    if (buffer.back().rfind("ret", 0) == std::string::npos && buffer.back().rfind("br", 0) == std::string::npos)
+    if (buffer.empty() || !buffer.back().isTerminator())
     {
-        emit("br label %" + ret);
+        emitBranch(label);
     }
 
-    label << ":";
-    emit(label.str());
-    return ret;
+    Instruction instruction(Opcode::LABEL);
+    instruction.labels[0] = label;
+    emit(instruction);
+    resetDivisionChecks();
+    /* other blocks jump here, nothing is known about the slots*/
+    slotStates.clear();
+    return label;
 }
 /**
- * helper function that returns (the name of) a fresh variable
+ * helper function that returns a fresh virtual register
  */
-string CodeBuffer::genReg(bool isGlobal)
+Value CodeBuffer::genReg()
 {
-    string regPrefix = (isGlobal) ? "@" : "%";
-    return regPrefix + "var_" + std::to_string(regCounter++);
+    return Value::reg(regCounter++);
+}
+
+int CodeBuffer::genGlobal()
+{
+    return regCounter++;
 }
 /**
  * writes command to the buffer, returns its location in the buffer
  */
-int CodeBuffer::emit(const string &s)
+int CodeBuffer::emit(const Instruction &instruction)
 {
-    buffer.push_back(s);
+    if (instruction.isTerminator() && !(instruction.op == Opcode::COND_BR && instruction.sub == BRANCH_UNLIKELY))
+    {
+        /* the stores may be read by the blocks it jumps to (the division error block reads nothing)*/
+        for (auto &slot : slotStates)
+        {
+            slot.second.unreadStore = -1;
+        }
+    }
+    buffer.push_back(instruction);
     return buffer.size() - 1;
 }
 
+void CodeBuffer::dropCode(int begin, int end)
+{
+    /* the dropped code may have had the checks the known divisors rely on*/
+    resetDivisionChecks();
+    /* forget the slot values that were loaded or stored by the dropped code*/
+    for (auto it = slotStates.begin(); it != slotStates.end();)
+    {
+        if (it->second.address >= begin && it->second.address < end)
+        {
+            it = slotStates.erase(it);
+            continue;
+        }
+        it++;
+    }
+    if (end >= static_cast<int>(buffer.size()))
+    {
+        buffer.erase(buffer.begin() + begin, buffer.end());
+        return;
+    }
+    for (int i = begin; i < end; i++)
+    {
+        buffer[i] = Instruction(Opcode::NOP);
+    }
+}
+
 void CodeBuffer::emitFile(const string &path)
 {
     std::ifstream file_stream(path);
@@ -76,84 +121,351 @@ void CodeBuffer::emitFile(const string &path)
     }
 }
 
+int CodeBuffer::getCallee(const string &name)
+{
+    auto it = calleeIndex.find(name);
+    if (it != calleeIndex.end())
+    {
+        return it->second;
+    }
+    int index = callees.size();
+    callees.push_back(name);
+    calleeIndex.emplace(name, index);
+    return index;
+}
+
+void CodeBuffer::setExtraOperands(Instruction &instruction, const vector<ExtraOperand> &operands)
+{
+    instruction.extraBegin = extraOperands.size();
+    instruction.extraCount = operands.size();
+    extraOperands.insert(extraOperands.end(), operands.begin(), operands.end());
+}
+
+void CodeBuffer::emitFunctionBegin(TypeId retType, const string &name, const vector<TypeId> &params)
+{
+    Instruction instruction(Opcode::FUNC_BEGIN, retType);
+    instruction.callee = getCallee(name);
+    vector<ExtraOperand> operands;
+    for (TypeId param : params)
+    {
+        operands.push_back({param, Value(), NO_LABEL});
+    }
+    setExtraOperands(instruction, operands);
+    functionStart = emit(instruction);
+    frameSlots.clear();
+    resetDivisionChecks();
+    slotStates.clear();
+    functionsCount++;
+}
+
+void CodeBuffer::emitFunctionEnd()
+{
+    if (divisionError != NO_LABEL)
+    {
+        /* every division check of the function branches here, after its last ret*/
+        Instruction label(Opcode::LABEL);
+        label.labels[0] = divisionError;
+        emit(label);
+        emitCall(TypeId::VOID, "division_by_zero", {});
+        emit(Instruction(Opcode::UNREACHABLE));
+        divisionError = NO_LABEL;
+    }
+    if (ssaBuilder != nullptr)
+    {
+        /* no load or store is left, the slots don't need any memory*/
+        ssaBuilder->run(functionStart);
+    }
+    else
+    {
+        emitFrame();
+    }
+    emit(Instruction(Opcode::FUNC_END));
+    if (buffer.size() > peakInstructions)
+    {
+        peakInstructions = buffer.size();
+    }
+#ifdef HW5_LLVM
+    if (llvmBackend != nullptr)
+    {
+        /* the module has the function now, like in streaming mode its instructions are freed*/
+        printGlobalBuffer();
+        llvmBackend->addFunction(functionStart, buffer.size());
+        flushedInstructions += buffer.size();
+        buffer.clear();
+        extraOperands.clear();
+        return;
+    }
+#endif
+    if (streaming)
+    {
+        /* no backpatching list points into a closed function, so the
+        buffer locations can be reused by the next one*/
+        printCodeBuffer();
+        flushedInstructions += buffer.size();
+        buffer.clear();
+        extraOperands.clear();
+    }
+}
+
+void CodeBuffer::enableSSA()
+{
+    if (ssaBuilder == nullptr)
+    {
+        ssaBuilder = new SSABuilder(*this);
+    }
+}
+
+#ifdef HW5_LLVM
+void CodeBuffer::enableLLVMBackend(int optLevel, bool bitcode)
+{
+    if (llvmBackend == nullptr)
+    {
+        llvmBackend = new LLVMBackend(*this, optLevel, bitcode);
+    }
+}
+
+void CodeBuffer::compileProgram()
+{
+    printGlobalBuffer();
+    llvmBackend->compile();
+}
+
+void CodeBuffer::runProgram(ostream *stats)
+{
+    llvmBackend->execute(stats);
+}
+#endif
+
+void CodeBuffer::startStreaming()
+{
+    printGlobalBuffer();
+    globalDefs.clear();
+    streaming = true;
+}
+
 /**
 accepts a list of {buffer_location, branch_label_index} items and a label.
-For each {buffer_location, branch_label_index} item in address_list, backpatches the branch command
-at buffer_location, at index branch_label_index (FIRST or SECOND), with the label.
-note - the function expects to find a '@' char in place of the missing label.
+For each {buffer_location, branch_label_index} item in address_list, backpatches the branch instruction
+at buffer_location, by writing the label into its branch_label_index (FIRST or SECOND) label slot.
 note - for unconditional branches (which contain only a single label) use FIRST as the branch_label_index.
 example #1:
-int loc1 = emit("br label @");  - unconditional branch missing a label. ~ Note the '@' ~
-bpatch(makelist({loc1,FIRST}),"my_label"); - location loc1 in the buffer will now contain the command "br label %my_label"
-note that index FIRST referes to the one and only label in the line.
+int loc1 = emitJump().first;  - unconditional branch missing a label.
+bpatch(makelist({loc1,FIRST}),my_label); - location loc1 in the buffer will now print as "br label %label_<my_label>"
+note that index FIRST referes to the one and only label in the instruction.
 example #2:
-int loc2 = emit("br i1 %cond, label @, label @"); - conditional branch missing two labels.
-bpatch(makelist({loc2,SECOND}),"my_false_label"); - location loc2 in the buffer will now contain the command "br i1 %cond, label @, label %my_false_label"
-bpatch(makelist({loc2,FIRST}),"my_true_label"); - location loc2 in the buffer will now contain the command "br i1 %cond, label @my_true_label, label %my_false_label"
+int loc2 = emitCondBranch(cond); - conditional branch missing two labels.
+bpatch(makelist({loc2,SECOND}),my_false_label); - the false target of loc2 is now set
+bpatch(makelist({loc2,FIRST}),my_true_label); - the true target of loc2 is now set
 */
-void CodeBuffer::bpatch(const vector<LabelLocation> &address_list, const std::string &label)
+void CodeBuffer::bpatch(const vector<LabelLocation> &address_list, LabelId label)
 {
     for (vector<LabelLocation>::const_iterator i = address_list.begin(); i != address_list.end(); i++)
     {
-        int address = (*i).first;
-        BranchLabelIndex labelIndex = (*i).second;
-        replace(buffer[address], "@", "%" + label, labelIndex);
+        buffer[(*i).first].labels[(*i).second] = label;
     }
 }
 /**
- * prints the content of the code buffer to stdout
+ * prints the content of the code buffer to the output
  */
 void CodeBuffer::printCodeBuffer()
 {
-    for (std::vector<string>::const_iterator it = buffer.begin(); it != buffer.end(); ++it)
+#ifdef HW5_LLVM
+    if (llvmBackend != nullptr)
+    {
+        /* all of the functions are in the module already*/
+        llvmBackend->finish(*out);
+        return;
+    }
+#endif
+    for (std::vector<Instruction>::const_iterator it = buffer.begin(); it != buffer.end(); ++it)
     {
-        cout << *it << endl;
+        printInstruction(*out, *it);
     }
 }
 
-string CodeBuffer::typeCode(string c_type)
+/* padd reg (which is of type typeToPadd) into i32 using zext*/
+Value CodeBuffer::paddReg(Value reg, TypeId typeToPadd)
 {
-    if (c_type == "void")
-        return "void";
-    if (c_type == "string")
-        return "i8*";
-    if (c_type == "bool")
-        return "i1";
-    if (c_type == "byte")
-        return "i8";
-    return "i32";
+    return convertTypes(typeToPadd, TypeId::INT, reg);
 }
 
-string CodeBuffer::getDefaultValue(string c_type)
+/* convert the reg from 'fromType' to 'toType' and put it a new reg*/
+Value CodeBuffer::convertTypes(TypeId fromType, TypeId toType, Value reg)
 {
-    if (c_type == "void")
-        return "";
-    if (c_type == "bool")
-        return "0";
-    return "0";
+    if(toType == TypeId::STRING) {
+        /* string is a ptr, we don't convert*/
+        return reg;
+    }
+    Instruction instruction(Opcode::CAST, fromType);
+    instruction.sub = static_cast<unsigned char>((toType == TypeId::INT) ? CastOp::ZEXT : CastOp::TRUNC);
+    instruction.toType = toType;
+    instruction.dst = genReg();
+    instruction.ops[0] = reg;
+    emit(instruction);
+
+    if (toType == TypeId::INT)
+    {
+        /* zero extending keeps the value nonzero*/
+        Value source = (reg.kind == Value::REG && sourceOf.count(reg.num)) ? sourceOf[reg.num] : reg;
+        sourceOf.emplace(instruction.dst.num, source);
+    }
+    return instruction.dst;
 }
 
-/* padd reg (which is of type typeToPadd) into i32 using zext*/
-string CodeBuffer::paddReg(string reg, string typeToPadd)
+Value CodeBuffer::emitBinary(BinaryOp op, TypeId type, Value left, Value right)
 {
-    return convertTypes(typeToPadd, "i32", reg);
+    Instruction instruction(Opcode::BINARY, type);
+    instruction.sub = static_cast<unsigned char>(op);
+    instruction.dst = genReg();
+    instruction.ops[0] = left;
+    instruction.ops[1] = right;
+    emit(instruction);
+    return instruction.dst;
 }
 
-/* convert the reg from 'fromType' to 'toType' and put it a new reg*/
-string CodeBuffer::convertTypes(string fromType, string toType, string reg)
+Value CodeBuffer::emitCompare(ComparePred pred, TypeId type, Value left, Value right)
 {
-    if(toType == "string") {
-        /* string is a ptr, we don't convert*/
-        return reg;
+    Instruction instruction(Opcode::ICMP, type);
+    instruction.sub = static_cast<unsigned char>(pred);
+    instruction.dst = genReg();
+    instruction.ops[0] = left;
+    instruction.ops[1] = right;
+    emit(instruction);
+    return instruction.dst;
+}
+
+int CodeBuffer::emitCondBranch(Value cond)
+{
+    Instruction instruction(Opcode::COND_BR, TypeId::BOOL);
+    instruction.ops[0] = cond;
+    return emit(instruction);
+}
+
+void CodeBuffer::emitBranch(LabelId target)
+{
+    Instruction instruction(Opcode::BR);
+    instruction.labels[0] = target;
+    emit(instruction);
+}
+
+Value CodeBuffer::emitCall(TypeId retType, const string &callee, const vector<ExtraOperand> &args)
+{
+    Instruction instruction(Opcode::CALL, retType);
+    instruction.callee = getCallee(callee);
+    if (retType != TypeId::VOID)
+    {
+        instruction.dst = genReg();
     }
-    string new_reg = genReg();
-    string op = (toType == "i32") ? "zext" : "trunc";
+    setExtraOperands(instruction, args);
+    emit(instruction);
+    return instruction.dst;
+}
 
-    emit(new_reg + " = " + op + " " + typeCode(fromType) + " " + reg + " to " + typeCode(toType));
+void CodeBuffer::emitReturn(TypeId type, Value value)
+{
+    /* the frame is gone after the ret, whatever wasn't read from it is dead*/
+    for (auto &slot : slotStates)
+    {
+        removeDeadStore(slot.second.unreadStore);
+    }
+    slotStates.clear();
+    Instruction instruction(Opcode::RET, type);
+    instruction.ops[0] = value;
+    emit(instruction);
+}
 
-    return new_reg;
+Value CodeBuffer::emitPhi(TypeId type, const vector<ExtraOperand> &incoming)
+{
+    Instruction instruction(Opcode::PHI, type);
+    instruction.dst = genReg();
+    setExtraOperands(instruction, incoming);
+    emit(instruction);
+    return instruction.dst;
 }
 
+void CodeBuffer::emitDivisionCheck(TypeId type, Value divisor)
+{
+    if (divisor.isImm() && divisor.num != 0)
+    {
+        elidedDivisionChecks++;
+        return;
+    }
+    long long key = valueKey(divisor);
+    if (checkedDivisors.count(key))
+    {
+        elidedDivisionChecks++;
+        return;
+    }
+
+    if (divisionError == NO_LABEL)
+    {
+        divisionError = labelCounter++;
+        if (divisionChecks == 0)
+        {
+            emitGlobal("!0 = !{!\"branch_weights\", i32 1, i32 1048575}");
+        }
+    }
+    Instruction branch(Opcode::COND_BR, TypeId::BOOL);
+    branch.sub = BRANCH_UNLIKELY;
+    branch.ops[0] = emitCompare(ComparePred::EQ, type, divisor, Value::imm(0));
+    branch.labels[0] = divisionError;
+    branch.labels[1] = labelCounter++;
+    emit(branch);
+    /* not a genLabel(): the check is the only way in, so the known divisors stay known*/
+    Instruction label(Opcode::LABEL);
+    label.labels[0] = branch.labels[1];
+    emit(label);
+
+    if (!divisor.isImm())
+    {
+        checkedDivisors.insert(key);
+    }
+    divisionChecks++;
+}
+
+long long CodeBuffer::valueKey(Value value) const
+{
+    auto source = sourceOf.find(value.num);
+    if (value.kind == Value::REG && source != sourceOf.end())
+    {
+        value = source->second;
+    }
+    return value.num * 4 + value.kind;
+}
+
+void CodeBuffer::removeDeadStore(int address)
+{
+    if (address < 0)
+    {
+        return;
+    }
+    buffer[address] = Instruction(Opcode::NOP);
+    deadStores++;
+}
+
+void CodeBuffer::resetDivisionChecks()
+{
+    checkedDivisors.clear();
+    sourceOf.clear();
+}
+
+Value CodeBuffer::stringLiteral(const string &content)
+{
+    stringUses++;
+    auto it = stringIndex.find(content);
+    if (it != stringIndex.end())
+    {
+        return Value::str(it->second);
+    }
+    PooledString pooled = {genGlobal(), static_cast<int>(content.length()) + 1};
+    emitGlobal("@var_" + to_string(pooled.global) + " = constant [" + to_string(pooled.length) + " x i8] c\"" +
+               content + "\\00\"");
+    stringBytes += pooled.length;
+    int index = strings.size();
+    strings.push_back(pooled);
+    stringIndex.emplace(content, index);
+    return Value::str(index);
+}
 /**
  * gets a pair<int,BranchLabelIndex> item of the form
  * {buffer_location, branch_label_index} and creates a list for it
@@ -176,16 +488,7 @@ vector<LabelLocation> CodeBuffer::merge(const vector<LabelLocation> &l1, const v
 
 LabelLocation CodeBuffer::emitJump()
 {
-    return LabelLocation(emit("br label @"), FIRST);
-}
-
-/**
- * Emit two lines needed for generating a label jump.
- * @param labelName the name of the label to emit
- */
-void CodeBuffer::labelEmit(string &labelName)
-{
-    emit(labelName + ":");
+    return LabelLocation(emit(Instruction(Opcode::BR)), FIRST);
 }
 
 // ******** Methods to handle the global section ********** //
@@ -197,81 +500,283 @@ void CodeBuffer::emitGlobal(const std::string &dataLine)
     globalDefs.push_back(dataLine);
 }
 /**
- * print the content of the global buffer to stdout
+ * print the content of the global buffer to the output
  */
 void CodeBuffer::printGlobalBuffer()
 {
+#ifdef HW5_LLVM
+    if (llvmBackend != nullptr)
+    {
+        /* the globals go to the module, which is printed as a whole at the end*/
+        llvmBackend->addGlobals(globalDefs);
+        globalDefs.clear();
+        return;
+    }
+#endif
     for (vector<string>::const_iterator it = globalDefs.begin(); it != globalDefs.end(); ++it)
     {
-        cout << *it << endl;
+        *out << *it << '\n';
+    }
+}
+
+void CodeBuffer::printStats(ostream &os) const
+{
+    size_t peak = (buffer.size() > peakInstructions) ? buffer.size() : peakInstructions;
+    os << "[codegen] " << (flushedInstructions + buffer.size()) << " instructions, peak buffer "
+       << peak << " instructions (" << peak * sizeof(Instruction) << " bytes)"
+       << (streaming ? ", streamed" : "") << std::endl;
+    os << "[codegen] " << frameBytes << " bytes of stack slots in " << functionsCount << " functions" << std::endl;
+    os << "[codegen] " << divisionChecks << " division checks, " << elidedDivisionChecks << " elided" << std::endl;
+    os << "[codegen] " << forwardedLoads << " loads forwarded, " << deadStores << " dead stores removed" << std::endl;
+    size_t hits = stringUses - strings.size();
+    os << "[strings] " << strings.size() << " unique out of " << stringUses << " literals, " << stringBytes
+       << " bytes, " << (stringUses ? 100 * hits / stringUses : 0) << "% dedup hits" << std::endl;
+    if (ssaBuilder != nullptr)
+    {
+        ssaBuilder->printStats(os);
+    }
+#ifdef HW5_LLVM
+    if (llvmBackend != nullptr)
+    {
+        llvmBackend->printStats(os);
     }
+#endif
 }
 
 // ******** Helper Methods ********** //
-bool replace(string &str, const string &from, const string &to, const BranchLabelIndex index)
+
+static const char *BINARY_OP_NAMES[] = {"add", "sub", "mul", "sdiv", "udiv", "and", "xor"};
+static const char *COMPARE_PRED_NAMES[] = {"eq", "ne", "sgt", "slt", "sge", "sle", "ugt", "ult", "uge", "ule"};
+static const char *CAST_OP_NAMES[] = {"zext", "trunc"};
+
+void CodeBuffer::printValue(ostream &os, const Value &value, TypeId type) const
 {
-    size_t pos;
-    if (index == SECOND)
+    switch (value.kind)
+    {
+    case Value::REG:
+        os << "%var_" << value.num;
+        break;
+    case Value::ARG:
+        os << "%" << value.num;
+        break;
+    case Value::IMM:
+        if (type == TypeId::BOOL)
+            os << (value.num ? "true" : "false");
+        else
+            os << value.num;
+        break;
+    case Value::STR:
     {
-        pos = str.find_last_of(from);
+        const PooledString &pooled = strings[value.num];
+        os << "getelementptr ([" << pooled.length << " x i8], [" << pooled.length << " x i8]* @var_"
+           << pooled.global << ", i32 0, i32 0)";
+        break;
     }
-    else
-    { // FIRST
-        pos = str.find_first_of(from);
+    case Value::NONE:
+        break;
     }
-    if (pos == string::npos)
-        return false;
-    str.replace(pos, from.length(), to);
-    return true;
+}
+
+static void printLabel(ostream &os, LabelId label)
+{
+    os << "label %label_" << label;
+}
+
+void CodeBuffer::printInstruction(ostream &os, const Instruction &instruction) const
+{
+    const char *type = llvmTypeName(instruction.type);
+    const ExtraOperand *extra = extraOperands.data() + instruction.extraBegin;
+
+    if (instruction.dst.valid())
+    {
+        printValue(os, instruction.dst, instruction.type);
+        os << " = ";
+    }
+
+    switch (instruction.op)
+    {
+    case Opcode::FUNC_BEGIN:
+        os << "define " << type << " @" << callees[instruction.callee] << "(";
+        for (int i = 0; i < instruction.extraCount; i++)
+        {
+            os << (i ? ", " : "") << llvmTypeName(extra[i].type);
+        }
+        os << ")\n{";
+        break;
+    case Opcode::FUNC_END:
+        os << "}";
+        break;
+    case Opcode::LABEL:
+        os << "label_" << instruction.labels[0] << ":";
+        break;
+    case Opcode::BR:
+        os << "br ";
+        printLabel(os, instruction.labels[0]);
+        break;
+    case Opcode::COND_BR:
+        os << "br i1 ";
+        printValue(os, instruction.ops[0], TypeId::BOOL);
+        os << ", ";
+        printLabel(os, instruction.labels[0]);
+        os << ", ";
+        printLabel(os, instruction.labels[1]);
+        if (instruction.sub == BRANCH_UNLIKELY)
+        {
+            os << ", !prof !0";
+        }
+        break;
+    case Opcode::RET:
+        os << "ret " << type;
+        if (instruction.type != TypeId::VOID)
+        {
+            os << " ";
+            printValue(os, instruction.ops[0], instruction.type);
+        }
+        break;
+    case Opcode::BINARY:
+        os << BINARY_OP_NAMES[instruction.sub] << " " << type << " ";
+        printValue(os, instruction.ops[0], instruction.type);
+        os << ", ";
+        printValue(os, instruction.ops[1], instruction.type);
+        break;
+    case Opcode::ICMP:
+        os << "icmp " << COMPARE_PRED_NAMES[instruction.sub] << " " << type << " ";
+        printValue(os, instruction.ops[0], instruction.type);
+        os << ", ";
+        printValue(os, instruction.ops[1], instruction.type);
+        break;
+    case Opcode::CAST:
+        os << CAST_OP_NAMES[instruction.sub] << " " << type << " ";
+        printValue(os, instruction.ops[0], instruction.type);
+        os << " to " << llvmTypeName(instruction.toType);
+        break;
+    case Opcode::PHI:
+        os << "phi " << type << " ";
+        for (int i = 0; i < instruction.extraCount; i++)
+        {
+            os << (i ? ", [" : "[");
+            printValue(os, extra[i].value, instruction.type);
+            os << ", %label_" << extra[i].label << "]";
+        }
+        break;
+    case Opcode::CALL:
+        os << "call " << type << " @" << callees[instruction.callee] << "(";
+        for (int i = 0; i < instruction.extraCount; i++)
+        {
+            os << (i ? ", " : "") << llvmTypeName(extra[i].type) << " ";
+            printValue(os, extra[i].value, extra[i].type);
+        }
+        os << ")";
+        break;
+    case Opcode::ALLOCA:
+        os << "alloca " << type;
+        break;
+    case Opcode::LOAD:
+        os << "load " << type << ", " << type << "* ";
+        printValue(os, instruction.ops[0], instruction.type);
+        break;
+    case Opcode::STORE:
+        os << "store " << type << " ";
+        printValue(os, instruction.ops[0], instruction.type);
+        os << ", " << type << "* ";
+        printValue(os, instruction.ops[1], instruction.type);
+        break;
+    case Opcode::UNREACHABLE:
+        os << "unreachable";
+        break;
+    case Opcode::NOP:
+        return;
+    }
+    os << '\n';
 }
 
 /** Methods for creating and getting addresses of varibales in the stack*/
 
+Value CodeBuffer::getSlot(int offset, TypeId type)
+{
+    if (offset >= static_cast<int>(frameSlots.size()))
+    {
+        frameSlots.resize(offset + 1);
+    }
+    for (const FrameSlot &slot : frameSlots[offset])
+    {
+        if (slot.type == type)
+        {
+            return slot.ptr;
+        }
+    }
+    Value ptr = genReg();
+    frameSlots[offset].push_back({type, ptr});
+    return ptr;
+}
+
 /**
- * Alloc a new register to possess the vakue in the stack of the variable
- * located in the specific offset after the rbp address of the scope.
- * @param rbp the base address of the scope
- * @param offset the offset (positive) from this base address
- *
- * @return the name of the register with the varibale value inside of it
+ * The frame is only known when the function is closed, so the allocas are inserted
+ * right after its "define" line then. Nothing is backpatched into the function anymore
+ * at that point, so moving its instructions is safe.
  */
-string CodeBuffer::loadVaribale(string rbp, int offset)
+void CodeBuffer::emitFrame()
 {
-    string reg = genReg();
-    string varPtr = genReg();
-    /* get the pointer to the correct address within the register varPtr*/
-    emit(varPtr + " = getelementptr i32, i32* " + rbp + ", i32 " + std::to_string(offset));
-    /* insert the value within the address to the new register*/
-    emit(reg + " = load i32, i32* " + varPtr);
-    return reg;
+    vector<Instruction> allocas;
+    for (const vector<FrameSlot> &slots : frameSlots)
+    {
+        for (const FrameSlot &slot : slots)
+        {
+            Instruction instruction(Opcode::ALLOCA, slot.type);
+            instruction.dst = slot.ptr;
+            allocas.push_back(instruction);
+            frameBytes += (slot.type == TypeId::INT) ? 4 : 1;
+        }
+    }
+    buffer.insert(buffer.begin() + functionStart + 1, allocas.begin(), allocas.end());
 }
+
 /**
- * Store a new variable in the offset address on the stack after rbp. The value
- * is identified with "reg" register name.
- * @param rbp the base address of the scope
- * @param offset the offset (positive) from this base address
- * @param reg the name of the register holding the value to store
+ * Load the value of the varibale located in the specific offset of the function's frame.
+ * @param offset the offset (positive) of the variable
+ * @param type the type of the variable
+ *
+ * @return the register with the varibale value inside of it (or the value itself, when
+ * this block already stored or loaded it)
  */
-void CodeBuffer::storeVariable(string rbp, int offset, string reg)
+Value CodeBuffer::loadVaribale(int offset, TypeId type)
 {
-    string varPtr = genReg();
-    /* get the pointer to the correct address within the register varPtr*/
-    emit(varPtr + " = getelementptr i32, i32* " + rbp + ", i32 " + std::to_string(offset));
-    /* store in the memory*/
-    emit("store i32 " + reg + ", i32* " + varPtr);
+    Value slot = getSlot(offset, type);
+    auto state = slotStates.find(slot.num);
+    if (state != slotStates.end())
+    {
+        state->second.unreadStore = -1;
+        forwardedLoads++;
+        return state->second.value;
+    }
+    Instruction load(Opcode::LOAD, type);
+    load.dst = genReg();
+    load.ops[0] = slot;
+    int address = emit(load);
+    sourceOf.emplace(load.dst.num, load.ops[0]);
+    slotStates[slot.num] = {load.dst, address, -1};
+    return load.dst;
 }
 /**
- * Alloc a new register and emit a line stating this register holds the
- * address of the new base pointer to use (the rbp)
- * @return the name of the register holding the rbp value
+ * Store a new value to the variable in the offset of the function's frame.
+ * @param offset the offset (positive) of the variable
+ * @param type the type of the variable
+ * @param reg the register (of the LLVM type of the variable) or immediate holding the value to store
  */
-string CodeBuffer::allocFunctionRbp()
+void CodeBuffer::storeVariable(int offset, TypeId type, Value reg)
 {
-    string rbp = genReg();
-    /* allocate memory for 50 variables on the stack, this is the new
-    base ptr for the function that is declared (outside)*/
-    emit(rbp + " = alloca i32, i32 50");
-    return rbp;
+    Instruction store(Opcode::STORE, type);
+    store.ops[0] = reg;
+    store.ops[1] = getSlot(offset, type);
+    auto state = slotStates.find(store.ops[1].num);
+    if (state != slotStates.end())
+    {
+        /* overwritten before this block read it*/
+        removeDeadStore(state->second.unreadStore);
+    }
+    int address = emit(store);
+    checkedDivisors.erase(valueKey(store.ops[1]));
+    slotStates[store.ops[1].num] = {reg, address, address};
 }
 
 /**************** Emit specific code methods *******************/
@@ -3,9 +3,17 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <ostream>
+#include "types.hpp"
 
 using namespace std;
 
+/* FWD decl*/
+class SSABuilder;
+class LLVMBackend;
+
 // this enum is used to distinguish between the two possible missing labels of a conditional branch in LLVM during backpatching.
 // for an unconditional branch (which contains only a single label) use FIRST.
 enum BranchLabelIndex
@@ -16,71 +24,384 @@ enum BranchLabelIndex
 
 typedef std::pair<int, BranchLabelIndex> LabelLocation;
 
+/* Labels are numbered per program and printed as "label_<id>"*/
+typedef int LabelId;
+
+/* the label slot of a branch that wasn't backpatched yet*/
+const LabelId NO_LABEL = -1;
+
+/**
+ * An operand of an instruction: a virtual register, an immediate value,
+ * one of the arguments of the current function, or a pointer to a string
+ * of the literal pool (a constant getelementptr expression).
+ */
+struct Value
+{
+    enum Kind : unsigned char
+    {
+        NONE,
+        REG,
+        IMM,
+        ARG,
+        STR,
+    };
+
+    Kind kind;
+    long long num;
+
+    Value() : kind(NONE), num(0) {}
+
+    static Value reg(int id) { return Value(REG, id); }
+    static Value imm(long long value) { return Value(IMM, value); }
+    static Value arg(int index) { return Value(ARG, index); }
+    static Value str(int index) { return Value(STR, index); }
+
+    bool valid() const { return kind != NONE; }
+    bool isImm() const { return kind == IMM; }
+
+    bool operator==(const Value &other) const { return kind == other.kind && num == other.num; }
+    bool operator!=(const Value &other) const { return !(*this == other); }
+
+private:
+    Value(Kind kind, long long num) : kind(kind), num(num) {}
+};
+
+enum class Opcode : unsigned char
+{
+    FUNC_BEGIN, // define <type> @<callee>(<extra types>) {
+    FUNC_END,   // }
+    LABEL,      // label_<labels[0]>:
+    BR,         // br label <labels[0]>
+    COND_BR,    // br i1 <ops[0]>, label <labels[0]>, label <labels[1]> [, !prof !0 when sub is BRANCH_UNLIKELY]
+    RET,        // ret <type> <ops[0]>
+    BINARY,     // <dst> = <sub> <type> <ops[0]>, <ops[1]>
+    ICMP,       // <dst> = icmp <sub> <type> <ops[0]>, <ops[1]>
+    CAST,       // <dst> = <sub> <type> <ops[0]> to <toType>
+    PHI,        // <dst> = phi <type> [<extra value>, <extra label>], ...
+    CALL,       // [<dst> =] call <type> @<callee>(<extra type> <extra value>, ...)
+    ALLOCA,     // <dst> = alloca <type>
+    LOAD,       // <dst> = load <type>, <type>* <ops[0]>
+    STORE,      // store <type> <ops[0]>, <type>* <ops[1]>
+    UNREACHABLE, // unreachable
+    NOP,        // removed instruction, prints nothing
+};
+
+/* the operation of a BINARY instruction*/
+enum class BinaryOp : unsigned char
+{
+    ADD,
+    SUB,
+    MUL,
+    SDIV,
+    UDIV,
+    AND,
+    XOR,
+};
+
+/* the predicate of an ICMP instruction*/
+enum class ComparePred : unsigned char
+{
+    EQ,
+    NE,
+    SGT,
+    SLT,
+    SGE,
+    SLE,
+    /* bytes are unsigned*/
+    UGT,
+    ULT,
+    UGE,
+    ULE,
+};
+
+/* the sub of a COND_BR whose labels[0] is a cold path (a runtime error)*/
+const unsigned char BRANCH_UNLIKELY = 1;
+
+/* the operation of a CAST instruction*/
+enum class CastOp : unsigned char
+{
+    ZEXT,
+    TRUNC,
+};
+
+/* a variable length operand (call argument, phi incoming value, function parameter)*/
+struct ExtraOperand
+{
+    TypeId type;
+    Value value;
+    LabelId label;
+};
+
+/**
+ * One LLVM instruction. Branch targets are label ids and a missing target is a
+ * NO_LABEL hole, so backpatching is a direct write to labels[index].
+ * The text is only produced by printCodeBuffer().
+ */
+struct Instruction
+{
+    Opcode op;
+    /* BinaryOp / ComparePred / CastOp / BRANCH_UNLIKELY according to op*/
+    unsigned char sub;
+    TypeId type;
+    /* the target type of a CAST*/
+    TypeId toType;
+    Value dst;
+    Value ops[2];
+    LabelId labels[2];
+    /* index of the callee name (CALL / FUNC_BEGIN)*/
+    int callee;
+    /* range of the instruction's operands in the extra operands pool*/
+    int extraBegin;
+    int extraCount;
+
+    Instruction(Opcode op, TypeId type = TypeId::NONE) : op(op), sub(0), type(type), toType(TypeId::NONE), dst(), ops(),
+                                                         labels{NO_LABEL, NO_LABEL}, callee(-1), extraBegin(0), extraCount(0) {}
+
+    bool isTerminator() const
+    {
+        return op == Opcode::BR || op == Opcode::COND_BR || op == Opcode::RET || op == Opcode::UNREACHABLE;
+    }
+};
+
 class CodeBuffer
 {
-    CodeBuffer();
+    friend class SSABuilder;
+    friend class LLVMBackend;
+
     CodeBuffer(CodeBuffer const &) = delete;
     void operator=(CodeBuffer const &);
-    std::vector<std::string> buffer;
+    std::vector<Instruction> buffer;
+    std::vector<ExtraOperand> extraOperands;
     std::vector<std::string> globalDefs;
-    
+    /* names of the called/defined functions, referenced by Instruction::callee*/
+    std::vector<std::string> callees;
+    std::unordered_map<std::string, int> calleeIndex;
+
     int regCounter;
+    int labelCounter;
+    /* a stack slot of a local variable*/
+    struct FrameSlot
+    {
+        TypeId type;
+        Value ptr;
+    };
+    /* the address of the FUNC_BEGIN of the current function, its allocas are inserted after it*/
+    int functionStart;
+    /* offset --> the slots of the current function at this offset. Variables of sibling
+     * scopes share an offset, so there is a slot per type that was stored there*/
+    std::vector<std::vector<FrameSlot>> frameSlots;
+    /* bytes of all of the stack slots allocated so far*/
+    size_t frameBytes;
+    size_t functionsCount;
+
+    /* the block of the current function that reports a division by zero, NO_LABEL until needed*/
+    LabelId divisionError;
+    /* the divisors already checked since the last label (keys of valueKey()).
+     * The check branches away on zero, so the code after it knows the divisor is nonzero*/
+    std::unordered_set<long long> checkedDivisors;
+    /* register --> the slot it was loaded from (or the slot / argument it was zero extended
+     * from), so a reload of a checked variable is known to be nonzero as well*/
+    std::unordered_map<long long, Value> sourceOf;
+    size_t divisionChecks;
+    size_t elidedDivisionChecks;
+
+    /* what the current block knows about a stack slot*/
+    struct SlotState
+    {
+        /* the value the slot holds*/
+        Value value;
+        /* the address of the load / store that gave it the value*/
+        int address;
+        /* the address of the last store to the slot if nothing read it since, -1 otherwise*/
+        int unreadStore;
+    };
+    /* slot --> its state. Only the current block is tracked, so this is reset at every label*/
+    std::unordered_map<long long, SlotState> slotStates;
+    size_t forwardedLoads;
+    size_t deadStores;
+
+    /* a string of the literal pool, printed once as @var_<global>*/
+    struct PooledString
+    {
+        int global;
+        /* including the \00*/
+        int length;
+    };
+    std::vector<PooledString> strings;
+    /* content --> its index in strings*/
+    std::unordered_map<std::string, int> stringIndex;
+    size_t stringUses;
+    size_t stringBytes;
+
+    /* when set, every function is printed and freed as soon as it is closed*/
+    bool streaming;
+    /* number of instructions already printed and freed by the streaming mode*/
+    size_t flushedInstructions;
+    /* promotes the locals of every closed function to SSA values, null when SSA mode is off*/
+    SSABuilder *ssaBuilder;
+    /* builds the program as an llvm::Module instead of printing it, null for the text output*/
+    LLVMBackend *llvmBackend;
+    /* the largest number of instructions the buffer held at once*/
+    size_t peakInstructions;
+    /* where the code and the globals are printed to (stdout by default)*/
+    ostream *out;
 
     /**************** Emit specific code methods *******************/
-    
+
     void emitPtintingFunctions();
 
     void emitDivisionFunction();
 
+    /* the checked divisors key of the value: the source of a register, or the value itself*/
+    long long valueKey(Value value) const;
+
+    /* forget the known nonzero divisors (at a label, where other paths join in)*/
+    void resetDivisionChecks();
+
+    /* remove a store that is overwritten (or the function returns) before anything reads it*/
+    void removeDeadStore(int address);
+
     void emitDeclareFunctions();
 
+    /* get the index of the function name in callees*/
+    int getCallee(const string &name);
+
+    /* append the operands to the extra operands pool and point the instruction at them*/
+    void setExtraOperands(Instruction &instruction, const vector<ExtraOperand> &operands);
+
+    void printValue(ostream &os, const Value &value, TypeId type) const;
+
+    void printInstruction(ostream &os, const Instruction &instruction) const;
+
+    /* get the slot of the variable at offset that holds a 'type', allocate it on first use*/
+    Value getSlot(int offset, TypeId type);
+
+    /* insert the allocas of the slots at the entry of the current function*/
+    void emitFrame();
+
 public:
-    static CodeBuffer &instance();
+    /* every compilation has its own code buffer (see CompilerContext)*/
+    CodeBuffer();
+    ~CodeBuffer();
+
+    /* print the code and the globals to os instead of stdout*/
+    void setOutput(ostream &os) { out = &os; }
 
     void emitGlobals();
 
     // ******** Methods to handle the code section ******** //
 
-    std::string genLabel();
+    /* emit a fresh label (and a jump to it if the previous instruction falls through) and return it*/
+    LabelId genLabel();
+
+    Value genReg();
+
+    /* get a fresh id for a global variable (printed as @var_<id>)*/
+    int genGlobal();
+
+    int emit(const Instruction &instruction);
 
-    std::string genReg(bool isGlobal = false);
+    /* the address the next emitted instruction will get*/
+    int nextAddress() const { return buffer.size(); }
 
-    int emit(const std::string &command);
+    /**
+     * Remove the (dead) instructions in [begin, end). When they are the tail of the
+     * buffer they are freed, otherwise they are replaced with NOPs so the addresses
+     * of the instructions after them stay valid for backpatching.
+     */
+    void dropCode(int begin, int end);
 
     void emitFile(const string &path);
-    void emitLeftBrace() { emit("{"); };
-    void emitRightBrace() { emit("}"); };
-    void returnFunc(string ret_type);
-    string typeCode(string ret_type);
-    string getDefaultValue(string ret_type);
-    string paddReg(string reg, string typeToPadd);
+
+    void emitFunctionBegin(TypeId retType, const string &name, const vector<TypeId> &params);
+    /* close the function. In streaming mode its code is printed and freed here*/
+    void emitFunctionEnd();
+
+    /**
+     * Print the globals emitted so far and switch to streaming mode: the code of every
+     * function is printed once its closing brace is reduced (all of its backpatching is
+     * done by then) and only the globals emitted afterwards are kept until printGlobalBuffer().
+     * @note on a compilation error the functions before it were already printed
+     */
+    void startStreaming();
+
+    /**
+     * Keep the locals in SSA values instead of stack slots: when a function is closed, its
+     * loads and stores are replaced with the reaching definitions and phis (see SSABuilder)
+     */
+    void enableSSA();
+
+    /**
+     * Build the program in process with LLVM (see LLVMBackend) and print it optimized with
+     * the -O<optLevel> pipeline, as bitcode if bitcode is set. Only available when built with 'make llvm'
+     */
+    void enableLLVMBackend(int optLevel, bool bitcode);
+
+    /* with the LLVM backend: compile the program with the JIT instead of printing it, then run it*/
+    void compileProgram();
+    void runProgram(ostream *stats);
+
+    const char *typeCode(TypeId type) { return llvmTypeName(type); }
+    const char *getDefaultValue(TypeId type) { return typeDefaultValue(type); }
+    Value paddReg(Value reg, TypeId typeToPadd);
     /* convert the reg from 'fromType' to 'toType' and put it a new reg*/
-    string convertTypes(string fromType, string toType, string reg);
+    Value convertTypes(TypeId fromType, TypeId toType, Value reg);
+
+    Value emitBinary(BinaryOp op, TypeId type, Value left, Value right);
+
+    Value emitCompare(ComparePred pred, TypeId type, Value left, Value right);
+
+    /* emit "br i1 cond, label @, label @" and return its address*/
+    int emitCondBranch(Value cond);
+
+    /* emit "br label target"*/
+    void emitBranch(LabelId target);
+
+    /* emit a call, the returned register is invalid for void functions*/
+    Value emitCall(TypeId retType, const string &callee, const vector<ExtraOperand> &args);
+
+    /* emit "ret type value", or "ret void" when type is VOID*/
+    void emitReturn(TypeId type, Value value = Value());
+
+    Value emitPhi(TypeId type, const vector<ExtraOperand> &incoming);
+
+    /**
+     * Make sure the divisor isn't zero before a division: branch to the function's division
+     * error block when it is. Nothing is emitted for a nonzero immediate or a divisor that
+     * was already checked in this block
+     */
+    void emitDivisionCheck(TypeId type, Value divisor);
+
+    /**
+     * Get a pointer to the string literal with the given content (without the quotes).
+     * Every distinct string is emitted to the globals once, the pointer is a constant expression
+     */
+    Value stringLiteral(const string &content);
 
     static vector<LabelLocation> makelist(LabelLocation item);
 
     static vector<LabelLocation> merge(const vector<LabelLocation> &l1, const vector<LabelLocation> &l2);
 
-    void bpatch(const vector<LabelLocation> &address_list, const std::string &label);
+    void bpatch(const vector<LabelLocation> &address_list, LabelId label);
 
     void printCodeBuffer();
 
-    void labelEmit(string &labelName);
-
     LabelLocation emitJump();
 
     // ******** Methods to handle the data section ******** //
     void emitGlobal(const string &dataLine);
-    
+
     void printGlobalBuffer();
 
+    void printStats(ostream &os) const;
+
     /** Methods for creating and getting addresses of varibales in the stack*/
 
-    string loadVaribale(string rbp, int offset);
+    /* load the variable at offset, the register has the LLVM type of 'type'*/
+    Value loadVaribale(int offset, TypeId type);
 
-    void storeVariable(string rbp, int offset, string reg);
-    
-    string allocFunctionRbp();
+    /* store the value in reg (already of the LLVM type of 'type') to the variable at offset*/
+    void storeVariable(int offset, TypeId type, Value reg);
 };
 
 #endif
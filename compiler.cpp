@@ -0,0 +1,102 @@
+#include "compiler.hpp"
+#include "source.hpp"
+#include "parser.tab.hpp"
+#include <sstream>
+#include <iostream>
+#include <assert.h>
+
+/* the interface of the reentrant scanner (lex.yy.c)*/
+typedef void *yyscan_t;
+struct yy_buffer_state;
+int yylex_init_extra(CompilerContext *extra, yyscan_t *scanner);
+int yylex_destroy(yyscan_t scanner);
+void yyset_in(FILE *in, yyscan_t scanner);
+yy_buffer_state *yy_scan_bytes(const char *bytes, int length, yyscan_t scanner);
+int yyget_lineno(yyscan_t scanner);
+
+static thread_local CompilerContext *s_current = nullptr;
+
+CompilerContext::CompilerContext() : nameInterner(), symbolTable(nameInterner), buffer(), nodeArena(),
+                                     m_scanner(nullptr), m_error()
+{
+    yylex_init_extra(this, &m_scanner);
+}
+
+CompilerContext::~CompilerContext()
+{
+    yylex_destroy(m_scanner);
+}
+
+CompilerContext &CompilerContext::current()
+{
+    assert(s_current != nullptr);
+    return *s_current;
+}
+
+int CompilerContext::line() const
+{
+    return yyget_lineno(m_scanner);
+}
+
+bool CompilerContext::run()
+{
+    /* a compilation may start another one on the same thread (a context per program)*/
+    CompilerContext *outer = s_current;
+    s_current = this;
+    bool ok = false;
+    try
+    {
+        ok = (yyparse(m_scanner, *this) == 0);
+    }
+    catch (const CompileError &error)
+    {
+        m_error = error;
+    }
+    /* destruct the nodes that are still alive (all of them after an error)*/
+    nodeArena.reset();
+    s_current = outer;
+    return ok;
+}
+
+bool CompilerContext::parse(FILE *in)
+{
+    yyset_in(in, m_scanner);
+    return run();
+}
+
+bool CompilerContext::parse(const string &source)
+{
+    /* the scanner works on its own copy of the text*/
+    yy_scan_bytes(source.data(), static_cast<int>(source.size()), m_scanner);
+    return run();
+}
+
+CompileResult CompilerContext::compile(const string &source)
+{
+    CompileResult result = {false, "", CompileError()};
+    std::ostringstream ir;
+    buffer.setOutput(ir);
+    try
+    {
+        /* the LLVM backend can fail outside of the parser too (the globals, the verifier)*/
+        buffer.emitGlobals();
+        if (parse(source))
+        {
+            buffer.printGlobalBuffer();
+            buffer.printCodeBuffer();
+            result.ok = true;
+            result.ir = ir.str();
+        }
+        else
+        {
+            result.error = m_error;
+        }
+    }
+    catch (const CompileError &error)
+    {
+        m_error = error;
+        result.error = error;
+    }
+    buffer.setOutput(std::cout);
+    return result;
+}
@@ -0,0 +1,80 @@
+#ifndef COMPI_HW5_COMPILER_H
+#define COMPI_HW5_COMPILER_H
+#include <cstdio>
+#include <string>
+#include "hw3_output.hpp"
+#include "symbol_table_intf.h"
+#include "bp.hpp"
+#include "arena.hpp"
+#include "interner.hpp"
+
+using std::string;
+
+/* the outcome of CompilerContext::compile()*/
+struct CompileResult
+{
+    bool ok;
+    /* the program (LLVM assembly) when ok*/
+    string ir;
+    /* the error that stopped the compilation when not ok*/
+    CompileError error;
+};
+
+/**
+ * All of the state of one compilation: the interned names, the symbol table, the code buffer,
+ * the AST arena and the reentrant scanner that feeds the pure parser. Nothing is global, so
+ * any number of programs can be compiled in the same process, one after the other or on
+ * different threads (a context is used by a single thread at a time).
+ * Errors don't exit: the first one stops the compilation and is returned.
+ * The compiler code reaches the context it runs in with current().
+ */
+class CompilerContext
+{
+public:
+    CompilerContext();
+
+    ~CompilerContext();
+
+    CompilerContext(CompilerContext const &) = delete;
+    void operator=(CompilerContext const &) = delete;
+
+    /**
+     * Compile a program into LLVM assembly in memory.
+     * A context compiles a single program, configure buffer (enableSSA()...) before calling it.
+     * @param source the text of the program
+     * @return the assembly, or the compilation error
+     */
+    CompileResult compile(const string &source);
+
+    /**
+     * Scan and parse the program, generating its code into buffer without printing it.
+     * @return false if there was a compilation error (see error())
+     */
+    bool parse(FILE *in);
+    bool parse(const string &source);
+
+    /* the error that stopped parse()*/
+    const CompileError &error() const { return m_error; }
+
+    /* the line the scanner is at*/
+    int line() const;
+
+    /* the context of the compilation running on this thread*/
+    static CompilerContext &current();
+
+    /* defined first - the symbol table interns the names of the library functions*/
+    NameInterner nameInterner;
+    SymbolTable symbolTable;
+    CodeBuffer buffer;
+    NodeArena nodeArena;
+
+private:
+    /* run the parser over the scanner's input, with this as the current context*/
+    bool run();
+
+    /* the flex scanner (yyscan_t)*/
+    void *m_scanner;
+    CompileError m_error;
+};
+
+#endif
@@ -42,62 +42,107 @@ string output::makeFunctionType(const string& retType, std::vector<string>& argT
     return res.str();
 }
 
+string output::typeToString(TypeId type) {
+    switch (type) {
+        case TypeId::BOOL:
+            return "BOOL";
+        case TypeId::BYTE:
+            return "BYTE";
+        case TypeId::INT:
+            return "INT";
+        case TypeId::VOID:
+            return "VOID";
+        default:
+            return "STRING";
+    }
+}
+
 void output::errorLex(int lineno){
-    cout << "line " << lineno << ":" << " lexical error" << endl;
+    stringstream message;
+    message << "line " << lineno << ":" << " lexical error";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorSyn(int lineno){
-    cout << "line " << lineno << ":" << " syntax error" << endl;
+    stringstream message;
+    message << "line " << lineno << ":" << " syntax error";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorUndef(int lineno, const string& id){
-    cout << "line " << lineno << ":" << " variable " << id << " is not defined" << endl;
+    stringstream message;
+    message << "line " << lineno << ":" << " variable " << id << " is not defined";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorDef(int lineno, const string& id){
-    cout << "line " << lineno << ":" << " identifier " << id << " is already defined" << endl;
+    stringstream message;
+    message << "line " << lineno << ":" << " identifier " << id << " is already defined";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorUndefFunc(int lineno, const string& id) {
-    cout << "line " << lineno << ":" << " function " << id << " is not defined" << endl;
+    stringstream message;
+    message << "line " << lineno << ":" << " function " << id << " is not defined";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorMismatch(int lineno){
-    cout << "line " << lineno << ":" << " type mismatch" << endl;
+    stringstream message;
+    message << "line " << lineno << ":" << " type mismatch";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorPrototypeMismatch(int lineno, const string& id) {
-    cout << "line " << lineno << ": prototype mismatch, function " << id << endl;
+    stringstream message;
+    message << "line " << lineno << ": prototype mismatch, function " << id;
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorUnexpectedBreak(int lineno) {
-    cout << "line " << lineno << ":" << " unexpected break statement" << endl;
+    stringstream message;
+    message << "line " << lineno << ":" << " unexpected break statement";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorUnexpectedContinue(int lineno) {
-    cout << "line " << lineno << ":" << " unexpected continue statement" << endl;	
+    stringstream message;
+    message << "line " << lineno << ":" << " unexpected continue statement";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorMainMissing() {
-    cout << "Program has no 'void main()' function" << endl;
+    stringstream message;
+    message << "Program has no 'void main()' function";
+    throw CompileError(0, message.str());
 }
 
 void output::errorByteTooLarge(int lineno, const string& value) {
-    cout << "line " << lineno << ": byte value " << value << " out of range" << endl;
+    stringstream message;
+    message << "line " << lineno << ": byte value " << value << " out of range";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorFuncNoOverride(int lineno, const string& id) {
-    cout << "line " << lineno << ": function " << id << " was declared before as non-override function" << endl;
+    stringstream message;
+    message << "line " << lineno << ": function " << id << " was declared before as non-override function";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorOverrideWithoutDeclaration(int lineno, const string& id) {
-    cout << "line " << lineno << ": function " << id << " attempt to override a function without declaring the current function as override" << endl;
+    stringstream message;
+    message << "line " << lineno << ": function " << id << " attempt to override a function without declaring the current function as override";
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorAmbiguousCall(int lineno, const string& id) {
-    cout << "line " << lineno << ": ambiguous call to overloaded function " << id << endl;
+    stringstream message;
+    message << "line " << lineno << ": ambiguous call to overloaded function " << id;
+    throw CompileError(lineno, message.str());
 }
 
 void output::errorMainOverride(int lineno){
-    cout << "line " << lineno << ": main is not allowed to be overridden" << endl;
+    stringstream message;
+    message << "line " << lineno << ": main is not allowed to be overridden";
+    throw CompileError(lineno, message.str());
 }
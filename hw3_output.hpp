@@ -3,8 +3,23 @@
 
 #include <vector>
 #include <string>
+#include "types.hpp"
 using namespace std;
 
+/**
+ * A compilation error: the diagnostic as it is printed (without the newline) and its line
+ * (0 for the missing main and for the errors of the LLVM backend). The error functions throw it,
+ * the CompilerContext returns it.
+ */
+struct CompileError
+{
+    int line;
+    string message;
+
+    CompileError() : line(0), message() {}
+    CompileError(int line, const string& message) : line(line), message(message) {}
+};
+
 namespace output{
     void endScope();
     void printID(const string& id, int offset, const string& type);
@@ -14,21 +29,24 @@ namespace output{
     */
     string makeFunctionType(const string& retType, vector<string>& argTypes);
 
-    void errorLex(int lineno);
-    void errorSyn(int lineno);
-    void errorUndef(int lineno, const string& id);
-    void errorDef(int lineno, const string& id);
-    void errorUndefFunc(int lineno, const string& id);
-    void errorMismatch(int lineno);
-    void errorPrototypeMismatch(int lineno, const string& id);
-    void errorUnexpectedBreak(int lineno);
-    void errorUnexpectedContinue(int lineno);
-    void errorMainMissing();
-    void errorByteTooLarge(int lineno, const string& value);
-    void errorFuncNoOverride(int lineno, const string& id);
-    void errorOverrideWithoutDeclaration(int lineno, const string& id);
-    void errorAmbiguousCall(int lineno, const string& id);
-    void errorMainOverride(int yylineno);
+    /* the name of the type as printed in the diagnostics (INT, BYTE, ...)*/
+    string typeToString(TypeId type);
+
+    [[noreturn]] void errorLex(int lineno);
+    [[noreturn]] void errorSyn(int lineno);
+    [[noreturn]] void errorUndef(int lineno, const string& id);
+    [[noreturn]] void errorDef(int lineno, const string& id);
+    [[noreturn]] void errorUndefFunc(int lineno, const string& id);
+    [[noreturn]] void errorMismatch(int lineno);
+    [[noreturn]] void errorPrototypeMismatch(int lineno, const string& id);
+    [[noreturn]] void errorUnexpectedBreak(int lineno);
+    [[noreturn]] void errorUnexpectedContinue(int lineno);
+    [[noreturn]] void errorMainMissing();
+    [[noreturn]] void errorByteTooLarge(int lineno, const string& value);
+    [[noreturn]] void errorFuncNoOverride(int lineno, const string& id);
+    [[noreturn]] void errorOverrideWithoutDeclaration(int lineno, const string& id);
+    [[noreturn]] void errorAmbiguousCall(int lineno, const string& id);
+    [[noreturn]] void errorMainOverride(int yylineno);
 }
 
 #endif
\ No newline at end of file
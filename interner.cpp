@@ -0,0 +1,29 @@
+#include "interner.hpp"
+
+NameId NameInterner::intern(const char *text, size_t length)
+{
+    m_lookups++;
+    m_lookupBytes += length;
+    auto it = m_index.find(std::string_view(text, length));
+    if (it != m_index.end())
+    {
+        return it->second;
+    }
+    NameId id = static_cast<NameId>(m_names.size());
+    m_names.emplace_back(text, length);
+    m_index.emplace(std::string_view(m_names.back()), id);
+    return id;
+}
+
+void NameInterner::printStats(std::ostream &os) const
+{
+    size_t uniqueBytes = 0;
+    for (auto &name : m_names)
+    {
+        uniqueBytes += name.size();
+    }
+    /* every lookup used to create (at least) one std::string of its own*/
+    size_t savedBytes = (m_lookupBytes - uniqueBytes) + (m_lookups - m_names.size()) * sizeof(string);
+    os << "[intern] " << m_names.size() << " unique names out of " << m_lookups << " occurrences, "
+       << uniqueBytes << " bytes stored, " << savedBytes << " bytes saved" << std::endl;
+}
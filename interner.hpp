@@ -0,0 +1,57 @@
+#ifndef COMPI_HW5_INTERNER_H
+#define COMPI_HW5_INTERNER_H
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <ostream>
+
+using std::string;
+
+/* Handle of an interned identifier. Two names are equal iff their handles are*/
+typedef unsigned int NameId;
+
+/* a NameId that doesn't belong to any identifier*/
+const NameId NO_NAME = static_cast<NameId>(-1);
+
+/**
+ * Stores every distinct identifier of the program once. The scanner interns each ID token
+ * and the AST and the symbol table carry the handle instead of a copy of the text.
+ */
+class NameInterner
+{
+public:
+    NameInterner() : m_names(), m_index(), m_lookups(0), m_lookupBytes(0) {}
+
+    NameInterner(NameInterner const &) = delete;
+    void operator=(NameInterner const &) = delete;
+
+    /**
+     * Get the handle of the given identifier, adding it if it wasn't seen before.
+     * @param text the identifier
+     * @param length the length of text
+     * @return the NameId of the identifier
+     */
+    NameId intern(const char *text, size_t length);
+
+    NameId intern(const string &text) { return intern(text.data(), text.size()); }
+
+    /* the text of an interned identifier*/
+    const string &str(NameId id) const { return m_names[id]; }
+
+    /* number of distinct identifiers*/
+    size_t size() const { return m_names.size(); }
+
+    /* print the number of unique names and the bytes saved by sharing them*/
+    void printStats(std::ostream &os) const;
+
+private:
+    /* a deque so the strings (and the views into them) never move*/
+    std::deque<string> m_names;
+    std::unordered_map<std::string_view, NameId> m_index;
+    /* number of intern() calls and the total length of the text they were given*/
+    size_t m_lookups;
+    size_t m_lookupBytes;
+};
+
+#endif
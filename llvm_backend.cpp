@@ -0,0 +1,488 @@
+#ifdef HW5_LLVM
+#include "llvm_backend.hpp"
+#include "hw3_output.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/PassInstrumentation.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/raw_os_ostream.h>
+
+using std::string;
+using Clock = std::chrono::steady_clock;
+
+/* the weights of a BRANCH_UNLIKELY branch, the same as the !0 the text backend prints*/
+static const uint32_t UNLIKELY_WEIGHT = 1;
+static const uint32_t LIKELY_WEIGHT = 1048575;
+
+struct LLVMBackend::State
+{
+    /* owned here until the JIT takes them*/
+    std::unique_ptr<llvm::LLVMContext> context;
+    std::unique_ptr<llvm::Module> module;
+    llvm::IRBuilder<> builder;
+
+    /* the current function*/
+    llvm::Function *function;
+    /* register --> its value in the current function*/
+    std::unordered_map<long long, llvm::Value *> regs;
+    /* label --> its block, created on the first reference and placed when the label is reached*/
+    std::unordered_map<LabelId, llvm::BasicBlock *> blocks;
+    /* the phis get their incoming values at the end of the function, some are defined after them*/
+    vector<std::pair<llvm::PHINode *, const Instruction *>> phis;
+
+    /* the JIT that compiled the module (it owns it then) and the main() it compiled*/
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    void (*main)();
+
+    State() : context(new llvm::LLVMContext()), module(new llvm::Module("fanc", *context)), builder(*context),
+              function(nullptr),
+              regs(), blocks(), phis(), jit(), main(nullptr) {}
+
+    llvm::Type *type(TypeId type)
+    {
+        switch (type)
+        {
+        case TypeId::BOOL:
+            return builder.getInt1Ty();
+        case TypeId::BYTE:
+            return builder.getInt8Ty();
+        case TypeId::INT:
+            return builder.getInt32Ty();
+        case TypeId::STRING:
+            return builder.getInt8PtrTy();
+        default:
+            return builder.getVoidTy();
+        }
+    }
+
+    llvm::BasicBlock *block(LabelId label)
+    {
+        llvm::BasicBlock *&block = blocks[label];
+        if (block == nullptr)
+        {
+            block = llvm::BasicBlock::Create(*context, "label_" + std::to_string(label));
+        }
+        return block;
+    }
+
+    /* the function with this name, declared with this signature if it wasn't seen yet*/
+    llvm::Function *getFunction(const string &name, TypeId retType, const ExtraOperand *params, int count)
+    {
+        llvm::Function *function = module->getFunction(name);
+        if (function != nullptr)
+        {
+            return function;
+        }
+        vector<llvm::Type *> paramTypes;
+        for (int i = 0; i < count; i++)
+        {
+            paramTypes.push_back(type(params[i].type));
+        }
+        llvm::FunctionType *functionType = llvm::FunctionType::get(type(retType), paramTypes, false);
+        return llvm::Function::Create(functionType, llvm::Function::ExternalLinkage, name, module.get());
+    }
+};
+
+/* LLVM's messages end with a newline, a CompileError's don't*/
+static string trimmed(string message)
+{
+    while (!message.empty() && message.back() == '\n')
+    {
+        message.pop_back();
+    }
+    return message;
+}
+
+LLVMBackend::LLVMBackend(const CodeBuffer &codeBuffer, int optLevel, bool bitcode) : m_code(codeBuffer),
+                                                                                     m_optLevel(optLevel),
+                                                                                     m_bitcode(bitcode),
+                                                                                     m_state(new State()),
+                                                                                     m_functions(0),
+                                                                                     m_instructions(0),
+                                                                                     m_pipelineSeconds(0),
+                                                                                     m_jitSeconds(0),
+                                                                                     m_passTimes() {}
+
+LLVMBackend::~LLVMBackend()
+{
+    delete m_state;
+}
+
+void LLVMBackend::addGlobals(const vector<string> &lines)
+{
+    if (lines.empty())
+        return;
+    string text;
+    for (const string &line : lines)
+    {
+        text += line;
+        text += '\n';
+    }
+    llvm::SMDiagnostic error;
+    std::unique_ptr<llvm::MemoryBuffer> source = llvm::MemoryBuffer::getMemBuffer(text, "globals");
+    if (llvm::parseAssemblyInto(source->getMemBufferRef(), m_state->module.get(), nullptr, error))
+    {
+        /* e.g. a broken print_functions.llvm*/
+        string message;
+        llvm::raw_string_ostream os(message);
+        error.print("hw5", os, false);
+        throw CompileError(0, trimmed(os.str()));
+    }
+}
+
+void LLVMBackend::addFunction(int begin, int end)
+{
+    State &state = *m_state;
+    llvm::IRBuilder<> &builder = state.builder;
+    const vector<Instruction> &code = m_code.buffer;
+
+    auto value = [&state, this](const Value &value, TypeId type) -> llvm::Value * {
+        switch (value.kind)
+        {
+        case Value::REG:
+            return state.regs.at(value.num);
+        case Value::IMM:
+            return llvm::ConstantInt::get(state.type(type), static_cast<uint64_t>(value.num), true);
+        case Value::ARG:
+            return state.function->getArg(value.num);
+        case Value::STR:
+        {
+            llvm::GlobalVariable *global =
+                state.module->getNamedGlobal("var_" + std::to_string(m_code.strings[value.num].global));
+            llvm::Constant *zero = state.builder.getInt32(0);
+            return llvm::ConstantExpr::getGetElementPtr(global->getValueType(), global,
+                                                        llvm::ArrayRef<llvm::Constant *>{zero, zero});
+        }
+        case Value::NONE:
+            break;
+        }
+        return nullptr;
+    };
+
+    for (int i = begin; i < end; i++)
+    {
+        const Instruction &instruction = code[i];
+        const ExtraOperand *extra = m_code.extraOperands.data() + instruction.extraBegin;
+        llvm::BasicBlock *current = builder.GetInsertBlock();
+        bool placed = (instruction.op == Opcode::LABEL || instruction.op == Opcode::NOP ||
+                       instruction.op == Opcode::FUNC_BEGIN || instruction.op == Opcode::FUNC_END);
+        if (!placed && current->getTerminator() != nullptr)
+        {
+            /* code after a terminator without a label, like the text backend it is put in a block of its own*/
+            builder.SetInsertPoint(llvm::BasicBlock::Create(*state.context, "", state.function));
+        }
+
+        llvm::Value *result = nullptr;
+        switch (instruction.op)
+        {
+        case Opcode::FUNC_BEGIN:
+            state.function = state.getFunction(m_code.callees[instruction.callee], instruction.type, extra,
+                                               instruction.extraCount);
+            state.regs.clear();
+            state.blocks.clear();
+            state.phis.clear();
+            builder.SetInsertPoint(llvm::BasicBlock::Create(*state.context, "entry", state.function));
+            break;
+        case Opcode::FUNC_END:
+            for (auto &phi : state.phis)
+            {
+                const ExtraOperand *incoming = m_code.extraOperands.data() + phi.second->extraBegin;
+                for (int e = 0; e < phi.second->extraCount; e++)
+                {
+                    phi.first->addIncoming(value(incoming[e].value, phi.second->type), state.block(incoming[e].label));
+                }
+            }
+            break;
+        case Opcode::LABEL:
+        {
+            llvm::BasicBlock *block = state.block(instruction.labels[0]);
+            if (current->getTerminator() == nullptr)
+            {
+                builder.CreateBr(block);
+            }
+            block->insertInto(state.function);
+            builder.SetInsertPoint(block);
+            break;
+        }
+        case Opcode::BR:
+            builder.CreateBr(state.block(instruction.labels[0]));
+            break;
+        case Opcode::COND_BR:
+        {
+            llvm::MDNode *weights = nullptr;
+            if (instruction.sub == BRANCH_UNLIKELY)
+            {
+                weights = llvm::MDBuilder(*state.context).createBranchWeights(UNLIKELY_WEIGHT, LIKELY_WEIGHT);
+            }
+            builder.CreateCondBr(value(instruction.ops[0], TypeId::BOOL), state.block(instruction.labels[0]),
+                                 state.block(instruction.labels[1]), weights);
+            break;
+        }
+        case Opcode::RET:
+            if (instruction.type == TypeId::VOID)
+                builder.CreateRetVoid();
+            else
+                builder.CreateRet(value(instruction.ops[0], instruction.type));
+            break;
+        case Opcode::BINARY:
+        {
+            static const llvm::Instruction::BinaryOps OPS[] = {
+                llvm::Instruction::Add, llvm::Instruction::Sub, llvm::Instruction::Mul, llvm::Instruction::SDiv,
+                llvm::Instruction::UDiv, llvm::Instruction::And, llvm::Instruction::Xor};
+            result = builder.CreateBinOp(OPS[instruction.sub], value(instruction.ops[0], instruction.type),
+                                         value(instruction.ops[1], instruction.type));
+            break;
+        }
+        case Opcode::ICMP:
+        {
+            static const llvm::CmpInst::Predicate PREDICATES[] = {
+                llvm::CmpInst::ICMP_EQ, llvm::CmpInst::ICMP_NE, llvm::CmpInst::ICMP_SGT, llvm::CmpInst::ICMP_SLT,
+                llvm::CmpInst::ICMP_SGE, llvm::CmpInst::ICMP_SLE, llvm::CmpInst::ICMP_UGT, llvm::CmpInst::ICMP_ULT,
+                llvm::CmpInst::ICMP_UGE, llvm::CmpInst::ICMP_ULE};
+            result = builder.CreateICmp(PREDICATES[instruction.sub], value(instruction.ops[0], instruction.type),
+                                        value(instruction.ops[1], instruction.type));
+            break;
+        }
+        case Opcode::CAST:
+        {
+            llvm::Value *operand = value(instruction.ops[0], instruction.type);
+            if (instruction.sub == static_cast<unsigned char>(CastOp::ZEXT))
+                result = builder.CreateZExt(operand, state.type(instruction.toType));
+            else
+                result = builder.CreateTrunc(operand, state.type(instruction.toType));
+            break;
+        }
+        case Opcode::PHI:
+        {
+            llvm::PHINode *phi = builder.CreatePHI(state.type(instruction.type), instruction.extraCount);
+            state.phis.push_back({phi, &instruction});
+            result = phi;
+            break;
+        }
+        case Opcode::CALL:
+        {
+            llvm::Function *callee = state.getFunction(m_code.callees[instruction.callee], instruction.type, extra,
+                                                       instruction.extraCount);
+            vector<llvm::Value *> args;
+            for (int e = 0; e < instruction.extraCount; e++)
+            {
+                args.push_back(value(extra[e].value, extra[e].type));
+            }
+            result = builder.CreateCall(callee, args);
+            break;
+        }
+        case Opcode::ALLOCA:
+            result = builder.CreateAlloca(state.type(instruction.type));
+            break;
+        case Opcode::LOAD:
+            result = builder.CreateLoad(state.type(instruction.type), value(instruction.ops[0], TypeId::NONE));
+            break;
+        case Opcode::STORE:
+            builder.CreateStore(value(instruction.ops[0], instruction.type), value(instruction.ops[1], TypeId::NONE));
+            break;
+        case Opcode::UNREACHABLE:
+            builder.CreateUnreachable();
+            break;
+        case Opcode::NOP:
+            continue;
+        }
+        if (instruction.dst.valid())
+        {
+            state.regs[instruction.dst.num] = result;
+        }
+        m_instructions++;
+    }
+    m_functions++;
+}
+
+void LLVMBackend::optimize()
+{
+    llvm::Module &module = *m_state->module;
+    string problems;
+    llvm::raw_string_ostream os(problems);
+    if (llvm::verifyModule(module, &os))
+    {
+        throw CompileError(0, "hw5: the generated module is invalid\n" + trimmed(os.str()));
+    }
+
+    /* every pass's own time: the time of the passes (and analyses) it ran is taken off*/
+    struct Running
+    {
+        string name;
+        Clock::time_point start;
+        double children;
+    };
+    vector<Running> running;
+    auto before = [&running](llvm::StringRef name) {
+        running.push_back({name.str(), Clock::now(), 0});
+    };
+    auto after = [&running, this]() {
+        Running pass = running.back();
+        running.pop_back();
+        double seconds = std::chrono::duration<double>(Clock::now() - pass.start).count();
+        if (!running.empty())
+        {
+            running.back().children += seconds;
+        }
+        PassTime &time = m_passTimes[pass.name];
+        time.runs++;
+        time.seconds += seconds - pass.children;
+    };
+    llvm::PassInstrumentationCallbacks callbacks;
+    callbacks.registerBeforeNonSkippedPassCallback([&before](llvm::StringRef name, llvm::Any) { before(name); });
+    callbacks.registerAfterPassCallback(
+        [&after](llvm::StringRef, llvm::Any, const llvm::PreservedAnalyses &) { after(); });
+    callbacks.registerAfterPassInvalidatedCallback(
+        [&after](llvm::StringRef, const llvm::PreservedAnalyses &) { after(); });
+    callbacks.registerBeforeAnalysisCallback([&before](llvm::StringRef name, llvm::Any) { before(name); });
+    callbacks.registerAfterAnalysisCallback([&after](llvm::StringRef, llvm::Any) { after(); });
+
+    llvm::LoopAnalysisManager loopAnalyses;
+    llvm::FunctionAnalysisManager functionAnalyses;
+    llvm::CGSCCAnalysisManager cgsccAnalyses;
+    llvm::ModuleAnalysisManager moduleAnalyses;
+    llvm::PassBuilder passBuilder(nullptr, llvm::PipelineTuningOptions(), llvm::None, &callbacks);
+    passBuilder.registerModuleAnalyses(moduleAnalyses);
+    passBuilder.registerCGSCCAnalyses(cgsccAnalyses);
+    passBuilder.registerFunctionAnalyses(functionAnalyses);
+    passBuilder.registerLoopAnalyses(loopAnalyses);
+    passBuilder.crossRegisterProxies(loopAnalyses, functionAnalyses, cgsccAnalyses, moduleAnalyses);
+
+    static const llvm::OptimizationLevel LEVELS[] = {llvm::OptimizationLevel::O0, llvm::OptimizationLevel::O1,
+                                                     llvm::OptimizationLevel::O2, llvm::OptimizationLevel::O3};
+    llvm::ModulePassManager pipeline = (m_optLevel == 0)
+                                           ? passBuilder.buildO0DefaultPipeline(LEVELS[0])
+                                           : passBuilder.buildPerModuleDefaultPipeline(LEVELS[m_optLevel]);
+    Clock::time_point start = Clock::now();
+    pipeline.run(module, moduleAnalyses);
+    m_pipelineSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void LLVMBackend::finish(std::ostream &os)
+{
+    optimize();
+    llvm::raw_os_ostream out(os);
+    if (m_bitcode)
+    {
+        /* the prelude was parsed into the module, the bitcode can be run by lli as is*/
+        llvm::WriteBitcodeToFile(*m_state->module, out);
+    }
+    else
+    {
+        m_state->module->print(out, nullptr);
+    }
+}
+
+/* where the execution time is reported (null when it isn't) and when the execution started.
+ * Static, the program may end in exit() in the middle of the JIT code*/
+static std::ostream *s_runStats = nullptr;
+static Clock::time_point s_executionStart;
+
+static void reportExecution()
+{
+    if (s_runStats != nullptr)
+    {
+        double seconds = std::chrono::duration<double>(Clock::now() - s_executionStart).count();
+        *s_runStats << "[run] execution " << seconds * 1000 << " ms" << std::endl;
+    }
+}
+
+/* the exit() of the JIT code (a division by zero), reports the execution before exiting*/
+static void exitHook(int status)
+{
+    reportExecution();
+    exit(status);
+}
+
+[[noreturn]] static void jitError(llvm::Error error)
+{
+    throw CompileError(0, "hw5: " + llvm::toString(std::move(error)));
+}
+
+void LLVMBackend::compile()
+{
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    Clock::time_point start = Clock::now();
+    auto jit = llvm::orc::LLJITBuilder().create();
+    if (!jit)
+        jitError(jit.takeError());
+
+    /* printf and friends come from this process, exit() is hooked*/
+    llvm::orc::JITDylib &library = (*jit)->getMainJITDylib();
+    auto process = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        (*jit)->getDataLayout().getGlobalPrefix());
+    if (!process)
+        jitError(process.takeError());
+    library.addGenerator(std::move(*process));
+    llvm::orc::SymbolMap hooks;
+    hooks[(*jit)->mangleAndIntern("exit")] = llvm::JITEvaluatedSymbol(
+        llvm::pointerToJITTargetAddress(&exitHook), llvm::JITSymbolFlags::Exported);
+    if (llvm::Error error = library.define(llvm::orc::absoluteSymbols(hooks)))
+        jitError(std::move(error));
+
+    /* optimize for the target the code runs on*/
+    m_state->module->setDataLayout((*jit)->getDataLayout());
+    m_state->module->setTargetTriple((*jit)->getTargetTriple().str());
+    optimize();
+
+    llvm::orc::ThreadSafeModule module(std::move(m_state->module), std::move(m_state->context));
+    if (llvm::Error error = (*jit)->addIRModule(std::move(module)))
+        jitError(std::move(error));
+    /* the lookup compiles the module*/
+    auto main = (*jit)->lookup("main");
+    if (!main)
+        jitError(main.takeError());
+    m_jitSeconds = std::chrono::duration<double>(Clock::now() - start).count() - m_pipelineSeconds;
+    m_state->main = llvm::jitTargetAddressToFunction<void (*)()>(main->getAddress());
+    m_state->jit = std::move(*jit);
+}
+
+void LLVMBackend::execute(std::ostream *stats)
+{
+    s_runStats = stats;
+    s_executionStart = Clock::now();
+    m_state->main();
+    reportExecution();
+}
+
+void LLVMBackend::printStats(std::ostream &os) const
+{
+    os << "[llvm] " << m_functions << " functions, " << m_instructions << " instructions built, O" << m_optLevel
+       << " pipeline in " << m_pipelineSeconds * 1000 << " ms";
+    if (m_jitSeconds > 0)
+    {
+        os << ", jit compiled in " << m_jitSeconds * 1000 << " ms";
+    }
+    os << std::endl;
+    vector<std::pair<string, PassTime>> passes(m_passTimes.begin(), m_passTimes.end());
+    std::sort(passes.begin(), passes.end(), [](const std::pair<string, PassTime> &a, const std::pair<string, PassTime> &b) {
+        return a.second.seconds > b.second.seconds;
+    });
+    for (const auto &pass : passes)
+    {
+        os << "[pass] " << pass.first << ": " << pass.second.runs << " runs, " << pass.second.seconds * 1000 << " ms"
+           << std::endl;
+    }
+}
+
+#endif
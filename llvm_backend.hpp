@@ -0,0 +1,75 @@
+#ifndef COMPI_HW5_LLVM_BACKEND_H
+#define COMPI_HW5_LLVM_BACKEND_H
+#include <ostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "bp.hpp"
+
+using std::vector;
+
+/**
+ * Builds the program as an llvm::Module in process instead of printing text: the globals
+ * (print_functions.llvm and the string literals) are parsed into the module, and every function
+ * is translated from the code buffer with an IRBuilder once it is closed. At the end the module
+ * is verified, optimized with the new pass manager's O0-O3 pipeline and printed (as text or as
+ * bitcode), or run with the JIT.
+ * Only built with 'make llvm' (HW5_LLVM), the LLVM objects are hidden in the .cpp.
+ */
+class LLVMBackend
+{
+public:
+    /* optLevel is 0-3, as in -O<n>. finish() writes bitcode instead of assembly when bitcode is set*/
+    LLVMBackend(const CodeBuffer &codeBuffer, int optLevel, bool bitcode);
+
+    ~LLVMBackend();
+
+    LLVMBackend(LLVMBackend const &) = delete;
+    void operator=(LLVMBackend const &) = delete;
+
+    /* parse lines of global definitions (LLVM assembly) into the module*/
+    void addGlobals(const vector<std::string> &lines);
+
+    /* translate the function in the code buffer at [begin, end) (FUNC_BEGIN to FUNC_END)*/
+    void addFunction(int begin, int end);
+
+    /* verify and optimize the module, then write it to os (as assembly or bitcode)*/
+    void finish(std::ostream &os);
+
+    /* verify and optimize the module and compile it with the ORC JIT, for execute()*/
+    void compile();
+
+    /**
+     * Call the main() of the compiled program. Its execution time is printed to stats
+     * (if it isn't null), even when the program ends with exit()
+     */
+    void execute(std::ostream *stats);
+
+    /* the pipeline time and the time of every pass, slowest first*/
+    void printStats(std::ostream &os) const;
+
+private:
+    struct State;
+
+    void optimize();
+
+    /* a pass's own time, without the passes it ran*/
+    struct PassTime
+    {
+        size_t runs;
+        double seconds;
+    };
+
+    const CodeBuffer &m_code;
+    int m_optLevel;
+    bool m_bitcode;
+    State *m_state;
+
+    size_t m_functions;
+    size_t m_instructions;
+    double m_pipelineSeconds;
+    double m_jitSeconds;
+    std::map<std::string, PassTime> m_passTimes;
+};
+
+#endif
@@ -0,0 +1,60 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+@var_3 = constant [7 x i8] c"folded\00"
+!0 = !{!"branch_weights", i32 1, i32 1048575}
+@var_7 = constant [12 x i8] c"unreachable\00"
+define i32 @half_2(i32)
+{
+label_0:
+%var_0 = sdiv i32 %0, 2
+ret i32 %var_0
+}
+define void @main()
+{
+label_5:
+call void @printi_1(i32 44)
+call void @printi_1(i32 88)
+call void @printi_1(i32 -1)
+call void @printi_1(i32 255)
+call void @printi_1(i32 -2147483648)
+%var_1 = add i32 7766279631452241919, 1
+call void @printi_1(i32 %var_1)
+call void @printi_1(i32 7)
+call void @printi_1(i32 35)
+%var_2 = call i32 @half_2(i32 13)
+call void @printi_1(i32 %var_2)
+call void @print_0(i8* getelementptr ([7 x i8], [7 x i8]* @var_3, i32 0, i32 0))
+call void @printi_1(i32 4)
+%var_5 = icmp eq i32 0, 0
+br i1 %var_5, label %label_3, label %label_4, !prof !0
+label_4:
+%var_6 = sdiv i32 1, 0
+call void @printi_1(i32 %var_6)
+call void @print_0(i8* getelementptr ([12 x i8], [12 x i8]* @var_7, i32 0, i32 0))
+ret void
+label_3:
+call void @division_by_zero()
+unreachable
+}
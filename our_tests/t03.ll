@@ -0,0 +1,104 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+@var_7 = constant [6 x i8] c"never\00"
+@var_9 = constant [3 x i8] c"or\00"
+@var_11 = constant [5 x i8] c"else\00"
+@var_13 = constant [15 x i8] c"left evaluated\00"
+@var_15 = constant [10 x i8] c"and false\00"
+@var_18 = constant [6 x i8] c"mixed\00"
+define i1 @say_2(i32, i1)
+{
+label_0:
+call void @printi_1(i32 %0)
+ret i1 %1
+}
+define i32 @pick_3(i32)
+{
+label_2:
+%var_0 = mul i32 %0, 2
+ret i32 %var_0
+}
+define void @main()
+{
+label_39:
+br label %label_3
+label_3:
+%var_26 = phi i32 [0, %label_39], [%var_3, %label_10], [%var_3, %label_5]
+%var_3 = add i32 %var_26, 1
+%var_4 = icmp eq i32 %var_3, 2
+br i1 %var_4, label %label_5, label %label_6
+label_5:
+br label %label_3
+label_6:
+call void @printi_1(i32 %var_3)
+%var_6 = icmp sge i32 %var_3, 4
+br i1 %var_6, label %label_9, label %label_10
+label_9:
+br label %label_11
+label_10:
+br label %label_3
+label_11:
+call void @print_0(i8* getelementptr ([3 x i8], [3 x i8]* @var_9, i32 0, i32 0))
+call void @print_0(i8* getelementptr ([5 x i8], [5 x i8]* @var_11, i32 0, i32 0))
+%var_12 = call i1 @say_2(i32 200, i1 false)
+br i1 %var_12, label %label_20, label %label_20
+label_20:
+call void @print_0(i8* getelementptr ([15 x i8], [15 x i8]* @var_13, i32 0, i32 0))
+br label %label_21
+label_21:
+%var_14 = call i1 @say_2(i32 200, i1 true)
+br i1 %var_14, label %label_24, label %label_24
+label_24:
+call void @print_0(i8* getelementptr ([10 x i8], [10 x i8]* @var_15, i32 0, i32 0))
+br label %label_25
+label_25:
+%var_17 = icmp sgt i32 %var_3, 3
+br i1 %var_17, label %label_28, label %label_29
+label_28:
+call void @print_0(i8* getelementptr ([6 x i8], [6 x i8]* @var_18, i32 0, i32 0))
+br label %label_29
+label_29:
+br i1 true, label %label_31, label %label_32
+label_31:
+%var_20 = call i32 @pick_3(i32 21)
+call void @printi_1(i32 %var_20)
+br label %label_32
+label_32:
+br label %label_33
+label_33:
+%var_29 = phi i32 [%var_3, %label_32], [%var_24, %label_37]
+%var_22 = icmp eq i32 %var_29, 10
+br i1 %var_22, label %label_35, label %label_36
+label_35:
+br label %label_38
+label_36:
+%var_24 = add i32 %var_29, 3
+br label %label_37
+label_37:
+br label %label_33
+label_38:
+call void @printi_1(i32 %var_29)
+ret void
+}
@@ -0,0 +1,127 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+@var_140 = constant [2 x i8] c"y\00"
+define i32 @sum_2(i32)
+{
+label_4:
+%var_0 = icmp eq i32 %0, 0
+br i1 %var_0, label %label_0, label %label_1
+label_0:
+ret i32 0
+label_1:
+%var_1 = trunc i32 %0 to i8
+%var_3 = sdiv i32 %0, 2
+%var_4 = mul i32 %var_3, 2
+%var_5 = icmp ne i32 %var_4, %0
+br i1 %var_5, label %label_2, label %label_3
+label_2:
+%var_7 = sub i32 %0, 1
+%var_8 = call i32 @sum_2(i32 %var_7)
+%var_10 = zext i8 %var_1 to i32
+%var_11 = add i32 %var_8, %var_10
+ret i32 %var_11
+label_3:
+%var_12 = sub i32 %0, 1
+%var_13 = call i32 @sum_2(i32 %var_12)
+%var_14 = add i32 %var_13, %0
+ret i32 %var_14
+}
+define void @main()
+{
+label_7:
+%var_76 = add i32 0, 1
+%var_77 = add i32 %var_76, 2
+%var_78 = add i32 %var_77, 3
+%var_79 = add i32 %var_78, 4
+%var_80 = add i32 %var_79, 5
+%var_81 = add i32 %var_80, 6
+%var_82 = add i32 %var_81, 7
+%var_83 = add i32 %var_82, 8
+%var_84 = add i32 %var_83, 9
+%var_85 = add i32 %var_84, 10
+%var_86 = add i32 %var_85, 11
+%var_87 = add i32 %var_86, 12
+%var_88 = add i32 %var_87, 13
+%var_89 = add i32 %var_88, 14
+%var_90 = add i32 %var_89, 15
+%var_91 = add i32 %var_90, 16
+%var_92 = add i32 %var_91, 17
+%var_93 = add i32 %var_92, 18
+%var_94 = add i32 %var_93, 19
+%var_95 = add i32 %var_94, 20
+%var_96 = add i32 %var_95, 21
+%var_97 = add i32 %var_96, 22
+%var_98 = add i32 %var_97, 23
+%var_99 = add i32 %var_98, 24
+%var_100 = add i32 %var_99, 25
+%var_101 = add i32 %var_100, 26
+%var_102 = add i32 %var_101, 27
+%var_103 = add i32 %var_102, 28
+%var_104 = add i32 %var_103, 29
+%var_105 = add i32 %var_104, 30
+%var_106 = add i32 %var_105, 31
+%var_107 = add i32 %var_106, 32
+%var_108 = add i32 %var_107, 33
+%var_109 = add i32 %var_108, 34
+%var_110 = add i32 %var_109, 35
+%var_111 = add i32 %var_110, 36
+%var_112 = add i32 %var_111, 37
+%var_113 = add i32 %var_112, 38
+%var_114 = add i32 %var_113, 39
+%var_115 = add i32 %var_114, 40
+%var_116 = add i32 %var_115, 41
+%var_117 = add i32 %var_116, 42
+%var_118 = add i32 %var_117, 43
+%var_119 = add i32 %var_118, 44
+%var_120 = add i32 %var_119, 45
+%var_121 = add i32 %var_120, 46
+%var_122 = add i32 %var_121, 47
+%var_123 = add i32 %var_122, 48
+%var_124 = add i32 %var_123, 49
+%var_125 = add i32 %var_124, 50
+%var_126 = add i32 %var_125, 51
+%var_127 = add i32 %var_126, 52
+%var_128 = add i32 %var_127, 53
+%var_129 = add i32 %var_128, 54
+%var_130 = add i32 %var_129, 55
+%var_131 = add i32 %var_130, 56
+%var_132 = add i32 %var_131, 57
+%var_133 = add i32 %var_132, 58
+%var_134 = add i32 %var_133, 59
+call void @printi_1(i32 %var_134)
+%var_136 = add i8 250, 10
+%var_137 = zext i8 %var_136 to i32
+call void @printi_1(i32 %var_137)
+%var_138 = icmp sgt i32 3, 2
+br i1 %var_138, label %label_5, label %label_6
+label_5:
+call void @print_0(i8* getelementptr ([2 x i8], [2 x i8]* @var_140, i32 0, i32 0))
+br label %label_6
+label_6:
+call void @printi_1(i32 -7)
+%var_142 = call i32 @sum_2(i32 20000)
+call void @printi_1(i32 %var_142)
+ret void
+}
@@ -0,0 +1,80 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+!0 = !{!"branch_weights", i32 1, i32 1048575}
+@var_28 = constant [12 x i8] c"unreachable\00"
+define i32 @f_2(i32, i8)
+{
+label_4:
+%var_0 = icmp eq i32 %0, 0
+br i1 %var_0, label %label_0, label %label_1, !prof !0
+label_1:
+%var_1 = sdiv i32 100, %0
+%var_2 = sdiv i32 50, %0
+%var_3 = add i32 %var_1, %var_2
+%var_5 = icmp eq i8 %1, 0
+br i1 %var_5, label %label_0, label %label_2, !prof !0
+label_2:
+%var_6 = udiv i8 200, %1
+%var_8 = sdiv i32 %var_3, 7
+%var_9 = udiv i8 %var_6, %1
+%var_10 = zext i8 %var_9 to i32
+%var_11 = add i32 %var_8, %var_10
+%var_14 = sdiv i32 %var_3, %0
+%var_16 = sub i32 %0, 1
+%var_17 = icmp eq i32 %var_16, 0
+br i1 %var_17, label %label_0, label %label_3, !prof !0
+label_3:
+%var_18 = sdiv i32 %var_3, %var_16
+%var_19 = add i32 %var_14, %var_18
+%var_20 = add i32 %var_19, %var_11
+ret i32 %var_20
+label_0:
+call void @division_by_zero()
+unreachable
+}
+define void @main()
+{
+label_9:
+%var_21 = call i32 @f_2(i32 5, i8 3)
+call void @printi_1(i32 %var_21)
+%var_22 = call i32 @f_2(i32 2, i8 1)
+call void @printi_1(i32 %var_22)
+%var_24 = icmp eq i32 0, 0
+br i1 %var_24, label %label_5, label %label_6
+label_5:
+call void @printi_1(i32 2)
+br label %label_6
+label_6:
+%var_26 = icmp eq i32 0, 0
+br i1 %var_26, label %label_7, label %label_8, !prof !0
+label_8:
+%var_27 = sdiv i32 7, 0
+call void @printi_1(i32 %var_27)
+call void @print_0(i8* getelementptr ([12 x i8], [12 x i8]* @var_28, i32 0, i32 0))
+ret void
+label_7:
+call void @division_by_zero()
+unreachable
+}
@@ -0,0 +1,122 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+@var_24 = constant [9 x i8] c"x is big\00"
+@var_28 = constant [6 x i8] c"x > y\00"
+@var_31 = constant [8 x i8] c"y < 150\00"
+@var_34 = constant [9 x i8] c"x >= 200\00"
+@var_49 = constant [8 x i8] c"bool ok\00"
+define i8 @mix_2(i8, i8)
+{
+label_0:
+%var_0 = mul i8 %0, %1
+%var_1 = add i8 %var_0, 7
+ret i8 %var_1
+}
+define i32 @widen_3(i8)
+{
+label_1:
+%var_2 = zext i8 %0 to i32
+ret i32 %var_2
+}
+define i1 @big_4(i8)
+{
+label_2:
+%var_3 = icmp ugt i8 %0, 127
+ret i1 %var_3
+}
+define void @main()
+{
+label_16:
+%var_6 = add i8 200, 100
+%var_7 = zext i8 %var_6 to i32
+call void @printi_1(i32 %var_7)
+%var_8 = sub i8 200, 100
+%var_9 = sub i8 %var_8, 100
+%var_10 = sub i8 %var_9, 100
+%var_11 = zext i8 %var_10 to i32
+call void @printi_1(i32 %var_11)
+%var_12 = call i8 @mix_2(i8 200, i8 100)
+%var_13 = zext i8 %var_12 to i32
+call void @printi_1(i32 %var_13)
+%var_14 = call i32 @widen_3(i8 200)
+%var_15 = add i32 %var_14, 1000
+call void @printi_1(i32 %var_15)
+%var_16 = add i32 200, 1000
+call void @printi_1(i32 %var_16)
+%var_17 = add i32 200, 100
+%var_18 = trunc i32 %var_17 to i8
+%var_19 = zext i8 %var_18 to i32
+call void @printi_1(i32 %var_19)
+%var_20 = mul i32 200, 2
+call void @printi_1(i32 %var_20)
+%var_21 = udiv i8 200, 3
+%var_22 = zext i8 %var_21 to i32
+call void @printi_1(i32 %var_22)
+%var_23 = call i1 @big_4(i8 200)
+br i1 %var_23, label %label_3, label %label_4
+label_3:
+call void @print_0(i8* getelementptr ([9 x i8], [9 x i8]* @var_24, i32 0, i32 0))
+br label %label_4
+label_4:
+%var_27 = icmp ugt i8 200, 100
+br i1 %var_27, label %label_5, label %label_6
+label_5:
+call void @print_0(i8* getelementptr ([6 x i8], [6 x i8]* @var_28, i32 0, i32 0))
+br label %label_6
+label_6:
+%var_30 = icmp ult i8 100, 150
+br i1 %var_30, label %label_7, label %label_8
+label_7:
+call void @print_0(i8* getelementptr ([8 x i8], [8 x i8]* @var_31, i32 0, i32 0))
+br label %label_8
+label_8:
+%var_33 = icmp uge i8 200, 200
+br i1 %var_33, label %label_9, label %label_10
+label_9:
+call void @print_0(i8* getelementptr ([9 x i8], [9 x i8]* @var_34, i32 0, i32 0))
+br label %label_10
+label_10:
+br label %label_11
+label_11:
+%var_55 = phi i8 [0, %label_10], [%var_40, %label_12]
+%var_56 = phi i32 [0, %label_10], [%var_42, %label_12]
+%var_38 = icmp ult i8 %var_55, 250
+br i1 %var_38, label %label_12, label %label_13
+label_12:
+%var_40 = add i8 %var_55, 10
+%var_42 = add i32 %var_56, 1
+br label %label_11
+label_13:
+call void @printi_1(i32 %var_56)
+%var_45 = zext i8 %var_55 to i32
+call void @printi_1(i32 %var_45)
+%var_47 = icmp eq i8 200, 200
+br i1 %var_47, label %label_14, label %label_15
+label_14:
+call void @print_0(i8* getelementptr ([8 x i8], [8 x i8]* @var_49, i32 0, i32 0))
+br label %label_15
+label_15:
+ret void
+}
@@ -0,0 +1,118 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+@var_3 = constant [2 x i8] c"T\00"
+@var_4 = constant [2 x i8] c"F\00"
+define i1 @lt_2(i32, i32)
+{
+label_0:
+%var_0 = icmp slt i32 %0, %1
+ret i1 %var_0
+}
+define i1 @nt_3(i1)
+{
+label_1:
+%var_1 = xor i1 %0, true
+ret i1 %var_1
+}
+define i1 @both_4(i1, i1)
+{
+label_6:
+br i1 %0, label %label_2, label %label_4
+label_2:
+br i1 %1, label %label_3, label %label_4
+label_3:
+br label %label_5
+label_4:
+br label %label_5
+label_5:
+%var_2 = phi i1 [true, %label_3], [false, %label_4]
+ret i1 %var_2
+}
+define void @show_5(i1)
+{
+label_10:
+br i1 %0, label %label_7, label %label_8
+label_7:
+call void @print_0(i8* getelementptr ([2 x i8], [2 x i8]* @var_3, i32 0, i32 0))
+br label %label_9
+label_8:
+call void @print_0(i8* getelementptr ([2 x i8], [2 x i8]* @var_4, i32 0, i32 0))
+br label %label_9
+label_9:
+ret void
+}
+define void @main()
+{
+label_19:
+%var_6 = icmp sgt i32 3, 2
+%var_8 = icmp eq i32 3, 3
+%var_9 = xor i1 %var_8, true
+%var_11 = call i1 @lt_2(i32 3, i32 10)
+%var_13 = call i1 @lt_2(i32 3, i32 1)
+%var_14 = xor i1 %var_13, true
+br i1 %var_6, label %label_11, label %label_13
+label_11:
+br i1 %var_9, label %label_13, label %label_12
+label_12:
+br label %label_14
+label_13:
+br label %label_14
+label_14:
+%var_17 = phi i1 [true, %label_12], [false, %label_13]
+%var_20 = icmp sgt i32 3, 100
+br i1 %var_20, label %label_16, label %label_15
+label_15:
+br i1 %var_11, label %label_16, label %label_17
+label_16:
+br label %label_18
+label_17:
+br label %label_18
+label_18:
+%var_22 = phi i1 [true, %label_16], [false, %label_17]
+%var_25 = xor i1 true, true
+%var_28 = call i1 @nt_3(i1 %var_6)
+call void @show_5(i1 %var_6)
+call void @show_5(i1 %var_9)
+call void @show_5(i1 %var_11)
+call void @show_5(i1 %var_14)
+call void @show_5(i1 %var_17)
+call void @show_5(i1 %var_22)
+call void @show_5(i1 true)
+call void @show_5(i1 %var_25)
+call void @show_5(i1 %var_28)
+%var_35 = icmp slt i32 3, 5
+call void @show_5(i1 %var_35)
+%var_36 = icmp slt i32 3, 5
+%var_37 = xor i1 %var_36, true
+call void @show_5(i1 %var_37)
+%var_38 = call i1 @both_4(i1 %var_6, i1 %var_11)
+call void @show_5(i1 %var_38)
+%var_39 = call i1 @both_4(i1 %var_6, i1 %var_9)
+call void @show_5(i1 %var_39)
+%var_40 = call i1 @nt_3(i1 %var_9)
+%var_41 = xor i1 %var_40, true
+call void @show_5(i1 %var_41)
+ret void
+}
@@ -0,0 +1,99 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+@var_23 = constant [4 x i8] c"bad\00"
+@var_24 = constant [5 x i8] c"good\00"
+!0 = !{!"branch_weights", i32 1, i32 1048575}
+define i32 @g_2(i32)
+{
+label_0:
+%var_0 = add i32 %0, 1
+ret i32 %var_0
+}
+define void @main()
+{
+label_16:
+br label %label_1
+label_1:
+%var_39 = phi i32 [0, %label_16], [%var_9, %label_4]
+%var_41 = phi i32 [7, %label_16], [1, %label_4]
+%var_5 = icmp slt i32 %var_39, 3
+br i1 %var_5, label %label_2, label %label_5
+label_2:
+%var_7 = icmp eq i32 %var_39, 1
+br i1 %var_7, label %label_3, label %label_4
+label_3:
+br label %label_5
+label_4:
+%var_9 = add i32 %var_39, 1
+br label %label_1
+label_5:
+%var_40 = phi i32 [%var_41, %label_1], [10, %label_3]
+call void @printi_1(i32 %var_40)
+%var_12 = call i32 @g_2(i32 5)
+%var_13 = add i32 %var_12, 5
+%var_14 = mul i32 %var_13, 2
+call void @printi_1(i32 %var_14)
+%var_16 = add i8 3, 1
+%var_17 = mul i8 %var_16, %var_16
+%var_18 = zext i8 %var_17 to i32
+call void @printi_1(i32 %var_18)
+%var_19 = icmp sgt i32 %var_14, 3
+%var_21 = xor i1 %var_19, true
+br i1 %var_21, label %label_6, label %label_7
+label_6:
+call void @print_0(i8* getelementptr ([4 x i8], [4 x i8]* @var_23, i32 0, i32 0))
+br label %label_8
+label_7:
+call void @print_0(i8* getelementptr ([5 x i8], [5 x i8]* @var_24, i32 0, i32 0))
+br label %label_8
+label_8:
+%var_26 = sub i32 3, 2
+%var_27 = icmp eq i32 %var_26, 0
+br i1 %var_27, label %label_9, label %label_10, !prof !0
+label_10:
+%var_28 = sdiv i32 3, %var_26
+call void @printi_1(i32 %var_28)
+br label %label_11
+label_11:
+%var_44 = phi i32 [0, %label_10], [%var_33, %label_14], [%var_33, %label_13]
+%var_45 = phi i32 [3, %label_10], [%var_37, %label_14], [%var_45, %label_13]
+%var_31 = icmp slt i32 %var_44, 5
+br i1 %var_31, label %label_12, label %label_15
+label_12:
+%var_33 = add i32 %var_44, 1
+%var_34 = icmp eq i32 %var_33, 2
+br i1 %var_34, label %label_13, label %label_14
+label_13:
+br label %label_11
+label_14:
+%var_37 = add i32 %var_45, %var_33
+br label %label_11
+label_15:
+call void @printi_1(i32 %var_45)
+ret void
+label_9:
+call void @division_by_zero()
+unreachable
+}
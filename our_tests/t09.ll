@@ -0,0 +1,371 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+define void @main()
+{
+label_100:
+%var_1 = icmp sge i32 0, 0
+br i1 %var_1, label %label_0, label %label_99
+label_0:
+%var_3 = add i32 0, 1
+br label %label_1
+label_1:
+%var_222 = phi i32 [0, %label_0], [%var_660, %label_97]
+%var_6 = icmp slt i32 %var_222, 2
+br i1 %var_6, label %label_2, label %label_98
+label_2:
+%var_8 = add i32 %var_3, 1
+%var_10 = add i32 %var_8, 1
+%var_12 = icmp sge i32 2, 0
+br i1 %var_12, label %label_3, label %label_97
+label_3:
+%var_14 = add i32 %var_10, 1
+br label %label_4
+label_4:
+%var_224 = phi i32 [2, %label_3], [%var_621, %label_95]
+%var_17 = icmp slt i32 %var_224, 5
+br i1 %var_17, label %label_5, label %label_96
+label_5:
+%var_19 = add i32 %var_14, 1
+%var_21 = add i32 %var_19, 1
+%var_23 = icmp sge i32 5, 0
+br i1 %var_23, label %label_6, label %label_95
+label_6:
+%var_25 = add i32 %var_21, 1
+br label %label_7
+label_7:
+%var_226 = phi i32 [5, %label_6], [%var_584, %label_93]
+%var_28 = icmp slt i32 %var_226, 8
+br i1 %var_28, label %label_8, label %label_94
+label_8:
+%var_30 = add i32 %var_25, 1
+%var_32 = add i32 %var_30, 1
+%var_34 = icmp sge i32 8, 0
+br i1 %var_34, label %label_9, label %label_93
+label_9:
+%var_36 = add i32 %var_32, 1
+br label %label_10
+label_10:
+%var_228 = phi i32 [8, %label_9], [%var_549, %label_91]
+%var_39 = icmp slt i32 %var_228, 11
+br i1 %var_39, label %label_11, label %label_92
+label_11:
+%var_41 = add i32 %var_36, 1
+%var_43 = add i32 %var_41, 1
+%var_45 = icmp sge i32 11, 0
+br i1 %var_45, label %label_12, label %label_91
+label_12:
+%var_47 = add i32 %var_43, 1
+br label %label_13
+label_13:
+%var_230 = phi i32 [11, %label_12], [%var_516, %label_89]
+%var_50 = icmp slt i32 %var_230, 14
+br i1 %var_50, label %label_14, label %label_90
+label_14:
+%var_52 = add i32 %var_47, 1
+%var_54 = add i32 %var_52, 1
+%var_56 = icmp sge i32 14, 0
+br i1 %var_56, label %label_15, label %label_89
+label_15:
+%var_58 = add i32 %var_54, 1
+br label %label_16
+label_16:
+%var_232 = phi i32 [14, %label_15], [%var_485, %label_87]
+%var_61 = icmp slt i32 %var_232, 17
+br i1 %var_61, label %label_17, label %label_88
+label_17:
+%var_63 = add i32 %var_58, 1
+%var_65 = add i32 %var_63, 1
+%var_67 = icmp sge i32 17, 0
+br i1 %var_67, label %label_18, label %label_87
+label_18:
+%var_69 = add i32 %var_65, 1
+br label %label_19
+label_19:
+%var_234 = phi i32 [17, %label_18], [%var_456, %label_85]
+%var_72 = icmp slt i32 %var_234, 20
+br i1 %var_72, label %label_20, label %label_86
+label_20:
+%var_74 = add i32 %var_69, 1
+%var_76 = add i32 %var_74, 1
+%var_78 = icmp sge i32 20, 0
+br i1 %var_78, label %label_21, label %label_85
+label_21:
+%var_80 = add i32 %var_76, 1
+br label %label_22
+label_22:
+%var_236 = phi i32 [20, %label_21], [%var_429, %label_83]
+%var_83 = icmp slt i32 %var_236, 23
+br i1 %var_83, label %label_23, label %label_84
+label_23:
+%var_85 = add i32 %var_80, 1
+%var_87 = add i32 %var_85, 1
+%var_89 = icmp sge i32 23, 0
+br i1 %var_89, label %label_24, label %label_83
+label_24:
+%var_91 = add i32 %var_87, 1
+br label %label_25
+label_25:
+%var_238 = phi i32 [23, %label_24], [%var_404, %label_81]
+%var_94 = icmp slt i32 %var_238, 26
+br i1 %var_94, label %label_26, label %label_82
+label_26:
+%var_96 = add i32 %var_91, 1
+%var_98 = add i32 %var_96, 1
+%var_100 = icmp sge i32 26, 0
+br i1 %var_100, label %label_27, label %label_81
+label_27:
+%var_102 = add i32 %var_98, 1
+br label %label_28
+label_28:
+%var_240 = phi i32 [26, %label_27], [%var_381, %label_79]
+%var_105 = icmp slt i32 %var_240, 29
+br i1 %var_105, label %label_29, label %label_80
+label_29:
+%var_107 = add i32 %var_102, 1
+%var_109 = add i32 %var_107, 1
+%var_111 = icmp sge i32 29, 0
+br i1 %var_111, label %label_30, label %label_79
+label_30:
+%var_113 = add i32 %var_109, 1
+br label %label_31
+label_31:
+%var_242 = phi i32 [29, %label_30], [%var_360, %label_77]
+%var_116 = icmp slt i32 %var_242, 32
+br i1 %var_116, label %label_32, label %label_78
+label_32:
+%var_118 = add i32 %var_113, 1
+%var_120 = add i32 %var_118, 1
+%var_122 = icmp sge i32 32, 0
+br i1 %var_122, label %label_33, label %label_77
+label_33:
+%var_124 = add i32 %var_120, 1
+br label %label_34
+label_34:
+%var_244 = phi i32 [32, %label_33], [%var_341, %label_75]
+%var_127 = icmp slt i32 %var_244, 35
+br i1 %var_127, label %label_35, label %label_76
+label_35:
+%var_129 = add i32 %var_124, 1
+%var_131 = add i32 %var_129, 1
+%var_133 = icmp sge i32 35, 0
+br i1 %var_133, label %label_36, label %label_75
+label_36:
+%var_135 = add i32 %var_131, 1
+br label %label_37
+label_37:
+%var_246 = phi i32 [35, %label_36], [%var_324, %label_73]
+%var_138 = icmp slt i32 %var_246, 38
+br i1 %var_138, label %label_38, label %label_74
+label_38:
+%var_140 = add i32 %var_135, 1
+%var_142 = add i32 %var_140, 1
+%var_144 = icmp sge i32 38, 0
+br i1 %var_144, label %label_39, label %label_73
+label_39:
+%var_146 = add i32 %var_142, 1
+br label %label_40
+label_40:
+%var_248 = phi i32 [38, %label_39], [%var_309, %label_71]
+%var_149 = icmp slt i32 %var_248, 41
+br i1 %var_149, label %label_41, label %label_72
+label_41:
+%var_151 = add i32 %var_146, 1
+%var_153 = add i32 %var_151, 1
+%var_155 = icmp sge i32 41, 0
+br i1 %var_155, label %label_42, label %label_71
+label_42:
+%var_157 = add i32 %var_153, 1
+br label %label_43
+label_43:
+%var_250 = phi i32 [41, %label_42], [%var_296, %label_69]
+%var_160 = icmp slt i32 %var_250, 44
+br i1 %var_160, label %label_44, label %label_70
+label_44:
+%var_162 = add i32 %var_157, 1
+%var_164 = add i32 %var_162, 1
+%var_166 = icmp sge i32 44, 0
+br i1 %var_166, label %label_45, label %label_69
+label_45:
+%var_168 = add i32 %var_164, 1
+br label %label_46
+label_46:
+%var_252 = phi i32 [44, %label_45], [%var_285, %label_67]
+%var_171 = icmp slt i32 %var_252, 47
+br i1 %var_171, label %label_47, label %label_68
+label_47:
+%var_173 = add i32 %var_168, 1
+%var_175 = add i32 %var_173, 1
+%var_177 = icmp sge i32 47, 0
+br i1 %var_177, label %label_48, label %label_67
+label_48:
+%var_179 = add i32 %var_175, 1
+br label %label_49
+label_49:
+%var_254 = phi i32 [47, %label_48], [%var_276, %label_65]
+%var_182 = icmp slt i32 %var_254, 50
+br i1 %var_182, label %label_50, label %label_66
+label_50:
+%var_184 = add i32 %var_179, 1
+%var_186 = add i32 %var_184, 1
+%var_188 = icmp sge i32 50, 0
+br i1 %var_188, label %label_51, label %label_65
+label_51:
+%var_190 = add i32 %var_186, 1
+br label %label_52
+label_52:
+%var_256 = phi i32 [50, %label_51], [%var_269, %label_63]
+%var_193 = icmp slt i32 %var_256, 53
+br i1 %var_193, label %label_53, label %label_64
+label_53:
+%var_195 = add i32 %var_190, 1
+%var_197 = add i32 %var_195, 1
+%var_199 = icmp sge i32 53, 0
+br i1 %var_199, label %label_54, label %label_63
+label_54:
+%var_201 = add i32 %var_197, 1
+br label %label_55
+label_55:
+%var_258 = phi i32 [53, %label_54], [%var_264, %label_61]
+%var_204 = icmp slt i32 %var_258, 56
+br i1 %var_204, label %label_56, label %label_62
+label_56:
+%var_206 = add i32 %var_201, 1
+%var_208 = add i32 %var_206, 1
+%var_210 = icmp sge i32 56, 0
+br i1 %var_210, label %label_57, label %label_61
+label_57:
+%var_212 = add i32 %var_208, 1
+br label %label_58
+label_58:
+%var_260 = phi i32 [56, %label_57], [59, %label_59]
+%var_215 = icmp slt i32 %var_260, 59
+br i1 %var_215, label %label_59, label %label_60
+label_59:
+%var_217 = add i32 %var_212, 1
+%var_219 = add i32 %var_217, 1
+call void @printi_1(i32 %var_219)
+br label %label_58
+label_60:
+br label %label_61
+label_61:
+%var_264 = phi i32 [56, %label_56], [%var_260, %label_60]
+br label %label_55
+label_62:
+br label %label_63
+label_63:
+%var_269 = phi i32 [53, %label_53], [%var_258, %label_62]
+br label %label_52
+label_64:
+br label %label_65
+label_65:
+%var_276 = phi i32 [50, %label_50], [%var_256, %label_64]
+br label %label_49
+label_66:
+br label %label_67
+label_67:
+%var_285 = phi i32 [47, %label_47], [%var_254, %label_66]
+br label %label_46
+label_68:
+br label %label_69
+label_69:
+%var_296 = phi i32 [44, %label_44], [%var_252, %label_68]
+br label %label_43
+label_70:
+br label %label_71
+label_71:
+%var_309 = phi i32 [41, %label_41], [%var_250, %label_70]
+br label %label_40
+label_72:
+br label %label_73
+label_73:
+%var_324 = phi i32 [38, %label_38], [%var_248, %label_72]
+br label %label_37
+label_74:
+br label %label_75
+label_75:
+%var_341 = phi i32 [35, %label_35], [%var_246, %label_74]
+br label %label_34
+label_76:
+br label %label_77
+label_77:
+%var_360 = phi i32 [32, %label_32], [%var_244, %label_76]
+br label %label_31
+label_78:
+br label %label_79
+label_79:
+%var_381 = phi i32 [29, %label_29], [%var_242, %label_78]
+br label %label_28
+label_80:
+br label %label_81
+label_81:
+%var_404 = phi i32 [26, %label_26], [%var_240, %label_80]
+br label %label_25
+label_82:
+br label %label_83
+label_83:
+%var_429 = phi i32 [23, %label_23], [%var_238, %label_82]
+br label %label_22
+label_84:
+br label %label_85
+label_85:
+%var_456 = phi i32 [20, %label_20], [%var_236, %label_84]
+br label %label_19
+label_86:
+br label %label_87
+label_87:
+%var_485 = phi i32 [17, %label_17], [%var_234, %label_86]
+br label %label_16
+label_88:
+br label %label_89
+label_89:
+%var_516 = phi i32 [14, %label_14], [%var_232, %label_88]
+br label %label_13
+label_90:
+br label %label_91
+label_91:
+%var_549 = phi i32 [11, %label_11], [%var_230, %label_90]
+br label %label_10
+label_92:
+br label %label_93
+label_93:
+%var_584 = phi i32 [8, %label_8], [%var_228, %label_92]
+br label %label_7
+label_94:
+br label %label_95
+label_95:
+%var_621 = phi i32 [5, %label_5], [%var_226, %label_94]
+br label %label_4
+label_96:
+br label %label_97
+label_97:
+%var_660 = phi i32 [2, %label_2], [%var_224, %label_96]
+br label %label_1
+label_98:
+br label %label_99
+label_99:
+%var_661 = phi i32 [0, %label_100], [%var_222, %label_98]
+call void @printi_1(i32 %var_661)
+ret void
+}
@@ -0,0 +1,138 @@
+declare i32 @printf(i8*, ...)
+declare void @exit(i32)
+@.int_specifier = constant [4 x i8] c"%d\0A\00"
+@.str_specifier = constant [4 x i8] c"%s\0A\00"
+
+define void @print_0(i8*) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.str_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i8* %0)
+    ret void
+}
+
+define void @printi_1(i32) {
+    %spec_ptr = getelementptr [4 x i8], [4 x i8]* @.int_specifier, i32 0, i32 0
+    call i32 (i8*, ...) @printf(i8* %spec_ptr, i32 %0)
+    ret void
+}
+
+@.DIV_BY_ZERO_ERROR = internal constant [23 x i8] c"Error division by zero\00"
+define void @division_by_zero() cold noreturn
+{
+    call void @print_0(i8* getelementptr([23 x i8], [23 x i8]* @.DIV_BY_ZERO_ERROR, i32 0, i32 0))
+    call void @exit(i32 0)
+    unreachable
+}
+@var_27 = constant [5 x i8] c"flag\00"
+define i32 @collatz_2(i32)
+{
+label_6:
+br label %label_0
+label_0:
+%var_16 = phi i32 [%0, %label_6], [%var_19, %label_4]
+%var_18 = phi i32 [0, %label_6], [%var_14, %label_4]
+%var_3 = icmp ne i32 %var_16, 1
+br i1 %var_3, label %label_1, label %label_5
+label_1:
+%var_5 = sdiv i32 %var_16, 2
+%var_6 = mul i32 %var_5, 2
+%var_7 = icmp eq i32 %var_6, %var_16
+br i1 %var_7, label %label_2, label %label_3
+label_2:
+%var_9 = sdiv i32 %var_16, 2
+br label %label_4
+label_3:
+%var_11 = mul i32 3, %var_16
+%var_12 = add i32 %var_11, 1
+br label %label_4
+label_4:
+%var_19 = phi i32 [%var_12, %label_3], [%var_9, %label_2]
+%var_14 = add i32 %var_18, 1
+br label %label_0
+label_5:
+ret i32 %var_18
+}
+define void @main()
+{
+label_28:
+%var_23 = icmp slt i32 1, 2
+br i1 %var_23, label %label_7, label %label_8
+label_7:
+br label %label_9
+label_8:
+br label %label_9
+label_9:
+%var_67 = phi i32 [1, %label_8], [10, %label_7]
+%var_68 = phi i32 [20, %label_8], [2, %label_7]
+%var_69 = phi i1 [false, %label_8], [true, %label_7]
+call void @printi_1(i32 %var_67)
+call void @printi_1(i32 %var_68)
+br i1 %var_69, label %label_10, label %label_11
+label_10:
+call void @print_0(i8* getelementptr ([5 x i8], [5 x i8]* @var_27, i32 0, i32 0))
+br label %label_11
+label_11:
+br label %label_12
+label_12:
+%var_70 = phi i32 [0, %label_11], [%var_45, %label_18]
+%var_71 = phi i8 [250, %label_11], [%var_34, %label_18]
+%var_72 = phi i32 [0, %label_11], [%var_74, %label_18]
+%var_32 = icmp slt i32 %var_70, 10
+br i1 %var_32, label %label_13, label %label_19
+label_13:
+%var_34 = add i8 %var_71, 3
+%var_35 = icmp ugt i8 %var_34, 100
+br i1 %var_35, label %label_14, label %label_15
+label_14:
+%var_38 = zext i8 %var_34 to i32
+%var_39 = add i32 %var_72, %var_38
+br label %label_18
+label_15:
+%var_41 = sub i32 %var_72, 1
+%var_43 = icmp eq i32 %var_70, 7
+br i1 %var_43, label %label_16, label %label_17
+label_16:
+br label %label_19
+label_17:
+br label %label_18
+label_18:
+%var_74 = phi i32 [%var_41, %label_17], [%var_39, %label_14]
+%var_45 = add i32 %var_70, 1
+br label %label_12
+label_19:
+%var_76 = phi i8 [%var_71, %label_12], [%var_34, %label_16]
+%var_77 = phi i32 [%var_72, %label_12], [%var_41, %label_16]
+%var_47 = zext i8 %var_76 to i32
+call void @printi_1(i32 %var_47)
+call void @printi_1(i32 %var_77)
+call void @printi_1(i32 %var_70)
+br label %label_20
+label_20:
+%var_79 = phi i32 [0, %label_19], [%var_64, %label_26]
+%var_82 = phi i32 [0, %label_19], [%var_81, %label_26]
+%var_53 = icmp slt i32 %var_79, 3
+br i1 %var_53, label %label_21, label %label_27
+label_21:
+br label %label_22
+label_22:
+%var_80 = phi i32 [%var_79, %label_21], [%var_61, %label_25], [%var_61, %label_24]
+%var_81 = phi i32 [%var_82, %label_21], [%var_60, %label_25], [%var_60, %label_24]
+%var_57 = icmp slt i32 %var_80, 3
+br i1 %var_57, label %label_23, label %label_26
+label_23:
+%var_60 = add i32 %var_81, %var_80
+%var_61 = add i32 %var_80, 1
+%var_62 = icmp eq i32 %var_61, 2
+br i1 %var_62, label %label_24, label %label_25
+label_24:
+br label %label_22
+label_25:
+br label %label_22
+label_26:
+%var_64 = add i32 %var_79, 1
+br label %label_20
+label_27:
+call void @printi_1(i32 %var_82)
+%var_66 = call i32 @collatz_2(i32 27)
+call void @printi_1(i32 %var_66)
+ret void
+}
@@ -0,0 +1,210 @@
+#include "output_sink.hpp"
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+OutputSink::OutputSink(size_t bufferSize) : m_fd(STDOUT_FILENO),
+                                            m_ownFd(false),
+                                            m_bufferSize(bufferSize),
+                                            m_current(bufferSize),
+                                            m_background(false),
+                                            m_writer(),
+                                            m_mutex(),
+                                            m_queued(),
+                                            m_written(),
+                                            m_queue(),
+                                            m_free(),
+                                            m_busy(false),
+                                            m_stop(false),
+                                            m_bytes(0),
+                                            m_syscalls(0),
+                                            m_chunks(0),
+                                            m_failed(false)
+{
+    setp(m_current.data(), m_current.data() + m_current.size());
+}
+
+OutputSink::~OutputSink()
+{
+    close();
+}
+
+bool OutputSink::open(const char *path)
+{
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+    sync();
+    if (m_ownFd)
+    {
+        ::close(m_fd);
+    }
+    m_fd = fd;
+    m_ownFd = true;
+    return true;
+}
+
+void OutputSink::startWriter()
+{
+    if (m_background)
+        return;
+    m_background = true;
+    m_stop = false;
+    m_writer = std::thread(&OutputSink::writerLoop, this);
+}
+
+void OutputSink::close()
+{
+    submit();
+    if (m_background)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_queued.notify_one();
+        m_writer.join();
+        m_background = false;
+    }
+    if (m_ownFd)
+    {
+        ::close(m_fd);
+        m_fd = STDOUT_FILENO;
+        m_ownFd = false;
+    }
+}
+
+OutputSink::int_type OutputSink::overflow(int_type ch)
+{
+    submit();
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int OutputSink::sync()
+{
+    submit();
+    waitWriter();
+    return m_failed ? -1 : 0;
+}
+
+void OutputSink::submit()
+{
+    size_t size = pptr() - pbase();
+    if (size == 0)
+        return;
+
+    std::deque<Chunk> chunk;
+    if (!m_background)
+    {
+        chunk.push_back({std::move(m_current), size});
+        writeChunks(chunk);
+        m_current = std::move(chunk.front().data);
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        /* don't let the code generator run too far ahead of the disk*/
+        m_written.wait(lock, [this] { return m_queue.size() < MAX_QUEUED_BUFFERS; });
+        m_queue.push_back({std::move(m_current), size});
+        if (m_free.empty())
+        {
+            m_current = vector<char>(m_bufferSize);
+        }
+        else
+        {
+            m_current = std::move(m_free.back());
+            m_free.pop_back();
+        }
+        lock.unlock();
+        m_queued.notify_one();
+    }
+    setp(m_current.data(), m_current.data() + m_current.size());
+}
+
+void OutputSink::waitWriter()
+{
+    if (!m_background)
+        return;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_written.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+void OutputSink::writeChunks(std::deque<Chunk> &chunks)
+{
+    /* one iovec per chunk, whatever a partial write left is retried*/
+    size_t first = 0;
+    size_t offset = 0;
+    while (first < chunks.size() && !m_failed)
+    {
+        struct iovec iov[IOV_MAX];
+        int count = 0;
+        for (size_t i = first; i < chunks.size() && count < IOV_MAX; i++, count++)
+        {
+            size_t skip = (i == first) ? offset : 0;
+            iov[count].iov_base = chunks[i].data.data() + skip;
+            iov[count].iov_len = chunks[i].size - skip;
+        }
+        ssize_t written = ::writev(m_fd, iov, count);
+        m_syscalls++;
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            m_failed = true;
+            break;
+        }
+        m_bytes += written;
+        /* skip the chunks that were fully written*/
+        size_t left = written;
+        while (first < chunks.size() && left >= chunks[first].size - offset)
+        {
+            left -= chunks[first].size - offset;
+            offset = 0;
+            first++;
+        }
+        offset += left;
+    }
+    m_chunks += chunks.size();
+}
+
+void OutputSink::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_queued.wait(lock, [this] { return !m_queue.empty() || m_stop; });
+        if (m_queue.empty())
+            break;
+        /* take every buffer that is queued and write them together*/
+        std::deque<Chunk> batch;
+        batch.swap(m_queue);
+        m_busy = true;
+        lock.unlock();
+        m_written.notify_all();
+
+        writeChunks(batch);
+
+        lock.lock();
+        for (auto &chunk : batch)
+        {
+            m_free.push_back(std::move(chunk.data));
+        }
+        m_busy = false;
+        m_written.notify_all();
+    }
+}
+
+void OutputSink::printStats(std::ostream &os) const
+{
+    os << "[output] " << m_bytes << " bytes in " << m_chunks << " buffers, " << m_syscalls << " writes"
+       << (m_failed ? ", write failed" : "") << std::endl;
+}
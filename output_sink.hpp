@@ -0,0 +1,106 @@
+#ifndef COMPI_HW5_OUTPUT_SINK_H
+#define COMPI_HW5_OUTPUT_SINK_H
+#include <cstddef>
+#include <streambuf>
+#include <ostream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using std::vector;
+
+/**
+ * Stream buffer the generated code is written through.
+ * Output is collected in large buffers and only handed to the OS when a buffer
+ * is full or on flush, instead of a write per line. With startWriter() the filled
+ * buffers are queued to a background thread that writes them (several at once
+ * with writev), so the output I/O overlaps with the parsing.
+ * Plug it into any std::ostream: std::ostream out(&sink);
+ */
+class OutputSink : public std::streambuf
+{
+public:
+    static const size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+    /* filled buffers waiting for the writer thread before the code generator blocks*/
+    static const size_t MAX_QUEUED_BUFFERS = 4;
+
+    /* writes to stdout until open() is called*/
+    OutputSink(size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /* flushes whatever is left, stops the writer thread and closes the file*/
+    ~OutputSink() override;
+
+    OutputSink(OutputSink const &) = delete;
+    void operator=(OutputSink const &) = delete;
+
+    /**
+     * Write to the file at path (created / truncated) instead of stdout.
+     * @return false if the file can't be opened
+     */
+    bool open(const char *path);
+
+    /* start the background writer thread. Call before anything is written*/
+    void startWriter();
+
+    /* flush, stop the writer thread and close the file. Called by the d'tor*/
+    void close();
+
+    size_t bytesWritten() const { return m_bytes; }
+
+    /* a write failed, the output is incomplete*/
+    bool failed() const { return m_failed; }
+
+    void printStats(std::ostream &os) const;
+
+protected:
+    /* the current buffer is full: hand it off and continue in a fresh one*/
+    int_type overflow(int_type ch) override;
+
+    /* hand off the current buffer and wait until everything is written*/
+    int sync() override;
+
+private:
+    struct Chunk
+    {
+        vector<char> data;
+        size_t size;
+    };
+
+    /* hand the filled part of the current buffer to the writer (or write it here)*/
+    void submit();
+
+    /* block until the writer thread wrote every queued buffer*/
+    void waitWriter();
+
+    /* write the chunks to the file, with as few syscalls as possible*/
+    void writeChunks(std::deque<Chunk> &chunks);
+
+    void writerLoop();
+
+    int m_fd;
+    bool m_ownFd;
+    size_t m_bufferSize;
+    vector<char> m_current;
+
+    bool m_background;
+    std::thread m_writer;
+    std::mutex m_mutex;
+    /* signaled when a buffer is queued (or on stop)*/
+    std::condition_variable m_queued;
+    /* signaled when the writer is done with a batch*/
+    std::condition_variable m_written;
+    std::deque<Chunk> m_queue;
+    /* buffers the writer is done with, reused for the next chunks*/
+    vector<vector<char>> m_free;
+    bool m_busy;
+    bool m_stop;
+
+    size_t m_bytes;
+    size_t m_syscalls;
+    size_t m_chunks;
+    bool m_failed;
+};
+
+#endif
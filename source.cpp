@@ -1,10 +1,27 @@
 #include "source.hpp"
 #include "hw3_output.hpp"
 #include "symbol_table_intf.h"
+#include "compiler.hpp"
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+
+/* the compilation this thread is running*/
+static inline CompilerContext &ctx()
+{
+    return CompilerContext::current();
+}
 
-extern int yylineno;
-extern SymbolTable symbolTable;
-extern CodeBuffer &buffer;
+void *Node::operator new(size_t size)
+{
+    return ctx().nodeArena.allocate(size);
+}
+
+void Node::operator delete(void *ptr)
+{
+    NodeArena::release(ptr);
+}
 
 BinOp::BinOp(const string op)
 {
@@ -14,10 +31,12 @@ BinOp::BinOp(const string op)
         this->opType = BinOp::OpTypes::OP_SUBTRACTION;
     else if (op == "*")
         this->opType = BinOp::OpTypes::OP_MULTIPLICATION;
-    else if (op == "/")
-        this->opType = BinOp::OpTypes::OP_DIVISION;
     else
-        exit(1);
+    {
+        /* the scanner only matches these operators*/
+        assert(op == "/");
+        this->opType = BinOp::OpTypes::OP_DIVISION;
+    }
 }
 
 RelOp::RelOp(const string op)
@@ -32,101 +51,193 @@ RelOp::RelOp(const string op)
         this->opType = RelOp::OpTypes::OP_LESS_THAN;
     else if (op == ">=")
         this->opType = RelOp::OpTypes::OP_GREATER_EQUAL;
-    else if (op == "<=")
-        this->opType = RelOp::OpTypes::OP_LESS_EQUAL;
     else
-        exit(1);
+    {
+        assert(op == "<=");
+        this->opType = RelOp::OpTypes::OP_LESS_EQUAL;
+    }
 }
 
 BoolOp::BoolOp(const string op)
 {
     if (op == "and")
         this->opType = BoolOp::OpTypes::OP_AND;
-    else if (op == "or")
-        this->opType = BoolOp::OpTypes::OP_OR;
     else
-        exit(1);
+    {
+        assert(op == "or");
+        this->opType = BoolOp::OpTypes::OP_OR;
+    }
 }
 
 Exp::Exp() : Node(){};
 
-Exp::Exp(const string type, const string value)
-    : Node(type), value(value)
+/* i32 arithmetic (two's complement wraparound) as the emitted instruction would do it*/
+static long long foldBinary(BinaryOp op, long long left, long long right)
 {
-    if (type == "byte" && stoi(value) > this->MAX_BYTE)
+    uint32_t l = static_cast<uint32_t>(left);
+    uint32_t r = static_cast<uint32_t>(right);
+    switch (op)
     {
-        output::errorByteTooLarge(yylineno, value);
-        exit(1);
+    case BinaryOp::ADD:
+        return static_cast<int32_t>(l + r);
+    case BinaryOp::SUB:
+        return static_cast<int32_t>(l - r);
+    case BinaryOp::MUL:
+        return static_cast<int32_t>(l * r);
+    case BinaryOp::SDIV:
+        return static_cast<int32_t>(l) / static_cast<int32_t>(r);
+    case BinaryOp::UDIV:
+        return static_cast<int32_t>(l / r);
+    case BinaryOp::AND:
+        return static_cast<int32_t>(l & r);
+    case BinaryOp::XOR:
+        return static_cast<int32_t>(l ^ r);
     }
+    return 0;
+}
 
-    this->value = value;
+/* signed i32 compare as the emitted icmp would do it*/
+static bool foldCompare(ComparePred pred, long long left, long long right)
+{
+    int32_t l = static_cast<int32_t>(left);
+    int32_t r = static_cast<int32_t>(right);
+    switch (pred)
+    {
+    case ComparePred::EQ:
+        return l == r;
+    case ComparePred::NE:
+        return l != r;
+    case ComparePred::SGT:
+        return l > r;
+    case ComparePred::SLT:
+        return l < r;
+    case ComparePred::SGE:
+        return l >= r;
+    case ComparePred::SLE:
+        return l <= r;
+    case ComparePred::UGT:
+        return static_cast<uint32_t>(l) > static_cast<uint32_t>(r);
+    case ComparePred::ULT:
+        return static_cast<uint32_t>(l) < static_cast<uint32_t>(r);
+    case ComparePred::UGE:
+        return static_cast<uint32_t>(l) >= static_cast<uint32_t>(r);
+    case ComparePred::ULE:
+        return static_cast<uint32_t>(l) <= static_cast<uint32_t>(r);
+    }
+    return false;
+}
 
-    /** When we have const 'true' or 'false' we can use reg to store them.
-     * This way 'evaluateBoolToReg()' won't be called in assignment or returning.
-     */
-    if (type == "bool")
+void Exp::setConst(long long value)
+{
+    this->is_const = true;
+    this->const_value = value;
+    this->reg = Value::imm(value);
+}
+
+void Exp::setKnownBool(bool value)
+{
+    this->is_const = true;
+    this->const_value = value;
+    this->true_list.clear();
+    this->false_list.clear();
+    this->cond = Value();
+}
+
+void Exp::copyFrom(const Exp *exp)
+{
+    this->reg = exp->reg;
+    this->is_const = exp->is_const;
+    this->const_value = exp->const_value;
+    this->true_list = exp->true_list;
+    this->false_list = exp->false_list;
+    this->next_list = exp->next_list;
+    this->cond = exp->cond;
+}
+
+Exp::Exp(const TypeId type, const string value)
+    : Node(type)
+{
+    /* 'true' and 'false' are known bools, they don't emit any branch*/
+    if (type == TypeId::BOOL)
     {
-        // this->reg = value;
-        int address = buffer.emit("br label @");
-        if (value == "true")
-            this->true_list = buffer.makelist(LabelLocation(address, FIRST));
-        else
-            this->false_list = buffer.makelist(LabelLocation(address, FIRST));
+        this->setKnownBool(value == "true");
     }
 
-    /* if this is a string value, add this to the global buffer*/
-    if (type == "string")
+    /* if this is a string value, get it from the literal pool (without the quotes)*/
+    if (type == TypeId::STRING)
+    {
+        this->reg = ctx().buffer.stringLiteral(value.substr(1, value.length() - 2));
+    }
+}
+
+/**
+ * The value of a decimal literal. One that doesn't fit in a long long (fits is false) wraps
+ * modulo 2^64, which keeps the low 32 bits LLVM takes of an i32 constant.
+ */
+static long long literalValue(const string &digits, bool &fits)
+{
+    errno = 0;
+    long long value = strtoll(digits.c_str(), nullptr, 10);
+    fits = (errno != ERANGE);
+    if (!fits)
     {
-        string str = value;
-        str.pop_back();
-        bool is_global = true;
-        string reg = buffer.genReg(is_global);
-        string stringLength = "[" + to_string(str.length()) + " x i8]";
-        string stringPointer = "getelementptr" + stringLength + ", " + stringLength + "* " + reg + ", i32 0, i32 0";
-        buffer.emitGlobal(reg + " = constant " + stringLength + " c" + str + "\\00\"");
-        reg.replace(0, 1, "%");
-        buffer.emit(reg + ".ptr = " + stringPointer);
-        this->reg = reg + ".ptr";
+        unsigned long long wrapped = 0;
+        for (char digit : digits)
+        {
+            wrapped = wrapped * 10 + (digit - '0');
+        }
+        value = static_cast<long long>(wrapped);
     }
+    return value;
 }
 
-Exp::Exp(const RawNumber *num, const string type)
+Exp::Exp(const RawNumber *num, const TypeId type)
     : Node(type)
 {
-    assert(type == "byte" || type == "int");
+    assert(type == TypeId::BYTE || type == TypeId::INT);
 
-    if (type == "byte" && stoi(num->value) > this->MAX_BYTE)
+    bool fits;
+    long long value = literalValue(num->value, fits);
+    if (type == TypeId::BYTE && (!fits || value > this->MAX_BYTE))
     {
-        output::errorByteTooLarge(yylineno, num->value);
-        exit(1);
+        output::errorByteTooLarge(ctx().line(), num->value);
     }
 
-    this->value = num->value;
-
     // Since this is a constant number, no register is needed and
-    // we can abuse the reg member to store the value itself
-    this->reg = num->value;
+    // the value itself is used as an immediate operand
+    this->reg = Value::imm(value);
+    this->is_literal = true;
+    /* still too large for a cast to byte*/
+    this->const_value = fits ? value : LLONG_MAX;
+    /* a literal that doesn't fit in an i32 isn't folded, LLVM truncates it as it always did*/
+    if (fits && value <= INT32_MAX)
+    {
+        this->setConst(value);
+    }
 }
 
 Exp::Exp(bool is_not, const Exp *exp)
     : Node(exp->type)
 {
-    if (exp->type != "bool")
+    this->is_const = exp->is_const;
+    this->const_value = exp->const_value;
+    if (exp->type != TypeId::BOOL)
     {
         this->reg = exp->reg;
-        this->value = exp->value;
+        this->is_literal = exp->is_literal;
         return;
     }
 
+    /* swapping the lists is enough to negate the branch on cond*/
+    this->cond = exp->cond;
     if (is_not)
     {
-        this->value = (exp->value == "true") ? "false" : "true";
+        this->const_value = !exp->const_value;
         this->true_list = exp->false_list;
         this->false_list = exp->true_list;
     }
     else
     {
-        this->value = exp->value;
         this->true_list = exp->true_list;
         this->false_list = exp->false_list;
     }
@@ -136,121 +247,188 @@ Exp::Exp(const Exp *left_exp, const BinOp *op, const Exp *right_exp)
 {
     if (!isNumericExp(left_exp) || !isNumericExp(right_exp))
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
 
-    this->type = (left_exp->type == "int" || right_exp->type == "int") ? "int" : "byte";
-    this->value = "0";
-    this->reg = buffer.genReg();
+    this->type = widerType(left_exp->type, right_exp->type);
 
-    string op_code;
+    BinaryOp op_code;
     switch (op->opType)
     {
     case BinOp::OpTypes::OP_ADDITION:
-        op_code = "add";
+        op_code = BinaryOp::ADD;
         break;
     case BinOp::OpTypes::OP_SUBTRACTION:
-        op_code = "sub";
+        op_code = BinaryOp::SUB;
         break;
     case BinOp::OpTypes::OP_MULTIPLICATION:
-        op_code = "mul";
+        op_code = BinaryOp::MUL;
         break;
     case BinOp::OpTypes::OP_DIVISION:
-        if (this->type == "int")
+        if (this->type == TypeId::INT)
         {
-            op_code = "sdiv";
+            op_code = BinaryOp::SDIV;
         }
         else
         {
-            op_code = "udiv";
+            op_code = BinaryOp::UDIV;
         }
-
-        buffer.emit("call void @check_division(i32 " + right_exp->reg + ")");
         break;
     }
 
-    buffer.emit(this->reg + " = " + op_code + " i32 " + left_exp->reg + ", " + right_exp->reg);
+    bool is_division = (op_code == BinaryOp::SDIV || op_code == BinaryOp::UDIV);
+    if (left_exp->is_const && right_exp->is_const)
+    {
+        /** Fold the operation, unless it has to fail at runtime:
+         * a division by zero prints its error and INT_MIN / -1 overflows */
+        long long left = left_exp->const_value;
+        long long right = right_exp->const_value;
+        bool runtime_error = is_division && (right == 0 || (op_code == BinaryOp::SDIV && left == INT32_MIN && right == -1));
+        if (!runtime_error)
+        {
+            long long result = foldBinary(op_code, left, right);
+            this->setConst((this->type == TypeId::BYTE) ? foldBinary(BinaryOp::AND, result, this->MAX_BYTE) : result);
+            return;
+        }
+    }
 
-    if (this->type == "byte")
+    /** Byte operations are calculated in i8, which wraps just like FanC bytes do.
+     * A byte operand is only widened when it meets an int */
+    Value left = left_exp->numericReg(this->type);
+    Value right = right_exp->numericReg(this->type);
+    if (is_division)
     {
-        this->reg = this->byteMask(this->reg);
+        ctx().buffer.emitDivisionCheck(this->type, right);
     }
+
+    this->reg = ctx().buffer.emitBinary(op_code, this->type, left, right);
 }
 
-string Exp::byteMask(string curr_reg)
+Value Exp::numericReg(TypeId wanted) const
 {
-    /** All BinOps are calculated as Ints.
-     * Threfore, we need to mask out additional bits when the type is Byte */
-    string new_reg = buffer.genReg();
-    buffer.emit(new_reg + " = and i32 255, " + curr_reg);
-    return new_reg;
+    if (this->type == wanted)
+    {
+        return this->reg;
+    }
+    /* a forwarded immediate is converted here, narrowing to a byte keeps the low 8 bits*/
+    if (this->reg.isImm())
+    {
+        bool mask = (wanted == TypeId::BYTE && this->type == TypeId::INT);
+        return mask ? Value::imm(foldBinary(BinaryOp::AND, this->reg.num, this->MAX_BYTE)) : this->reg;
+    }
+    return ctx().buffer.convertTypes(this->type, wanted, this->reg);
 }
 
 Exp::Exp(const Exp *left_exp, const BoolOp *op, const MarkerM *mark, const Exp *right_exp)
-    : Node("bool")
+    : Node(TypeId::BOOL)
 {
     if (!isBooleanExp(left_exp) || !isBooleanExp(right_exp))
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
+    }
+
+    /* the value of the left operand that decides the result without the right one*/
+    bool dominant = (op->opType == BoolOp::OpTypes::OP_OR);
+    if (left_exp->is_const)
+    {
+        if (left_exp->const_value == dominant)
+        {
+            /* short circuit: the right operand is never evaluated*/
+            ctx().buffer.dropCode(mark->start, ctx().buffer.nextAddress());
+            this->setKnownBool(dominant);
+        }
+        else
+        {
+            /* the result is the right operand, the left one just falls through to it*/
+            ctx().buffer.dropCode(mark->start, mark->end);
+            this->copyFrom(right_exp);
+        }
+        return;
+    }
+    if (right_exp->is_const)
+    {
+        /* a known bool has no code, the marker is the last thing emitted*/
+        ctx().buffer.dropCode(mark->start, mark->end);
+        if (right_exp->const_value == dominant)
+        {
+            /* the left operand is still evaluated (it may call functions), but both of its lists lead to the same result*/
+            vector<LabelLocation> all = ctx().buffer.merge(left_exp->true_list, left_exp->false_list);
+            this->true_list = dominant ? all : vector<LabelLocation>();
+            this->false_list = dominant ? vector<LabelLocation>() : all;
+        }
+        else
+        {
+            this->copyFrom(left_exp);
+        }
+        return;
     }
 
     switch (op->opType)
     {
     case BoolOp::OpTypes::OP_OR:
-        buffer.bpatch(left_exp->false_list, mark->quad);
-        this->true_list = buffer.merge(left_exp->true_list, right_exp->true_list);
+        ctx().buffer.bpatch(left_exp->false_list, mark->quad);
+        this->true_list = ctx().buffer.merge(left_exp->true_list, right_exp->true_list);
         this->false_list = vector<LabelLocation>(right_exp->false_list);
         break;
     case BoolOp::OpTypes::OP_AND:
-        buffer.bpatch(left_exp->true_list, mark->quad);
+        ctx().buffer.bpatch(left_exp->true_list, mark->quad);
         this->true_list = vector<LabelLocation>(right_exp->true_list);
-        this->false_list = buffer.merge(left_exp->false_list, right_exp->false_list);
+        this->false_list = ctx().buffer.merge(left_exp->false_list, right_exp->false_list);
         break;
     }
 }
 
 Exp::Exp(const Exp *left_exp, const RelOp *op, const Exp *right_exp)
-    : Node("bool")
+    : Node(TypeId::BOOL)
 {
     if (!isNumericExp(left_exp) || !isNumericExp(right_exp))
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
 
-    /* not using this->reg so that it remains empty. That way it is not: in_reg()*/
-    string reg = buffer.genReg();
-
-    string op_code;
+    ComparePred op_code;
     switch (op->opType)
     {
     case RelOp::OpTypes::OP_EQUAL:
-        op_code = "eq";
+        op_code = ComparePred::EQ;
         break;
     case RelOp::OpTypes::OP_NOT_EQUAL:
-        op_code = "ne";
+        op_code = ComparePred::NE;
         break;
     case RelOp::OpTypes::OP_GREATER_THAN:
-        op_code = "sgt";
+        op_code = ComparePred::SGT;
         break;
     case RelOp::OpTypes::OP_LESS_THAN:
-        op_code = "slt";
+        op_code = ComparePred::SLT;
         break;
     case RelOp::OpTypes::OP_GREATER_EQUAL:
-        op_code = "sge";
+        op_code = ComparePred::SGE;
         break;
     case RelOp::OpTypes::OP_LESS_EQUAL:
-        op_code = "sle";
+        op_code = ComparePred::SLE;
         break;
     }
 
-    string compare_code = reg + " = icmp " + op_code + " i32 " + left_exp->reg + ", " + right_exp->reg;
-    buffer.emit(compare_code);
-    int address = buffer.emit("br i1 " + reg + ", label @, label @");
-    this->true_list = buffer.makelist(LabelLocation(address, FIRST));
-    this->false_list = buffer.makelist(LabelLocation(address, SECOND));
+    if (left_exp->is_const && right_exp->is_const)
+    {
+        this->setKnownBool(foldCompare(op_code, left_exp->const_value, right_exp->const_value));
+        return;
+    }
+
+    TypeId compare_type = widerType(left_exp->type, right_exp->type);
+    if (compare_type == TypeId::BYTE && op_code != ComparePred::EQ && op_code != ComparePred::NE)
+    {
+        /* the signed predicates are right after EQ and NE, the unsigned ones after them*/
+        op_code = static_cast<ComparePred>(static_cast<int>(op_code) + 4);
+    }
+
+    /* not using this->reg so that it remains empty. That way it is not: in_reg()*/
+    Value reg = ctx().buffer.emitCompare(op_code, compare_type, left_exp->numericReg(compare_type),
+                                   right_exp->numericReg(compare_type));
+    int address = ctx().buffer.emitCondBranch(reg);
+    this->true_list = ctx().buffer.makelist(LabelLocation(address, FIRST));
+    this->false_list = ctx().buffer.makelist(LabelLocation(address, SECOND));
+    this->cond = reg;
 }
 
 Exp::Exp(const Type *new_type, const Exp *exp)
@@ -258,122 +436,127 @@ Exp::Exp(const Type *new_type, const Exp *exp)
     // Check if type conversion is valid
     if (!isNumericExp(exp) || !isNumericType(new_type))
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
 
-    if (new_type->type == "byte" && stoi(exp->value) > this->MAX_BYTE)
+    if (new_type->type == TypeId::BYTE && exp->is_literal && exp->const_value > this->MAX_BYTE)
     {
-        output::errorByteTooLarge(yylineno, exp->value);
-        exit(1);
+        output::errorByteTooLarge(ctx().line(), to_string(exp->const_value));
     }
 
     this->type = new_type->type;
-    this->value = exp->value;
     this->reg = exp->reg;
+    this->is_literal = exp->is_literal;
+
+    this->const_value = exp->const_value;
 
-    if (this->type == "byte" && exp->type == "int")
+    if (exp->is_const)
+    {
+        bool mask = (this->type == TypeId::BYTE && exp->type == TypeId::INT);
+        this->setConst(mask ? foldBinary(BinaryOp::AND, exp->const_value, this->MAX_BYTE) : exp->const_value);
+    }
+    else
     {
-        this->reg = this->byteMask(this->reg);
+        /* trunc to a byte, zext to an int*/
+        this->reg = exp->numericReg(this->type);
     }
 }
 
 Exp::Exp(const Id *id)
 {
-    if (!symbolTable.isSymbolExist(id->name))
+    if (!ctx().symbolTable.isSymbolExist(id->name))
     {
-        output::errorUndef(yylineno, id->name);
-        exit(1);
+        output::errorUndef(ctx().line(), ctx().nameInterner.str(id->name));
     }
 
-    this->type = symbolTable.getSymbolType(id->name);
-    /* We can't get the symbol's real value,
-       so we'll use "0" which is a legal BYTE value */
-    this->value = "0";
+    this->type = ctx().symbolTable.getSymbolType(id->name);
 
-    int offset = symbolTable.getSymbolOffset(id->name);
+    int offset = ctx().symbolTable.getSymbolOffset(id->name);
     bool is_arg = (offset < 0);
-    this->reg = (is_arg) ? this->getArgReg(offset, this->type) : this->loadGetVar(offset);
 
-    if (this->type == "bool")
+    if (this->type == TypeId::BOOL)
     {
         /** If the stored varibale is boolean, we beed to create a conditioned branch
          * command and lists for backpatching it.
-         * To do so we'll compare current value with 'false' and store the result
-         * in a new register.
+         * Both bool args and bool variables are i1, so we branch on the value itself.
+         * this->reg stays empty to make sure this exp is not in_reg()
          */
-        string new_reg = buffer.genReg();
-        string compare_code = new_reg + " = icmp ne i32 0, " + this->reg;
-        /* to make sure this exp is not in_reg()*/
-        this->reg = "";
-        buffer.emit(compare_code);
-        int address = buffer.emit("br i1 " + new_reg + ", label @, label @");
-        this->true_list = buffer.makelist(LabelLocation(address, FIRST));
-        this->false_list = buffer.makelist(LabelLocation(address, SECOND));
+        Value value = (is_arg) ? Value::arg(-1 - offset) : ctx().buffer.loadVaribale(offset, TypeId::BOOL);
+        int address = ctx().buffer.emitCondBranch(value);
+        this->true_list = ctx().buffer.makelist(LabelLocation(address, FIRST));
+        this->false_list = ctx().buffer.makelist(LabelLocation(address, SECOND));
+        this->cond = value;
+    }
+    else
+    {
+        this->reg = (is_arg) ? Value::arg(-1 - offset) : ctx().buffer.loadVaribale(offset, this->type);
     }
 
     this->name = id->name;
 }
 
-string Exp::loadGetVar(int offset)
-{
-    string rbp = symbolTable.getCurrentRbp();
-    return buffer.loadVaribale(rbp, offset);
-}
-
 Exp::Exp(const Call *call) : Node(call->return_type)
 {
     this->reg = call->reg;
-    if (this->type == "bool")
+    if (this->type == TypeId::BOOL)
     {
         /* emit a bp according to the result, and create a list for later backpatch*/
-        int address = buffer.emit("br i1 " + this->reg + " , label @, label @");
-        this->true_list = buffer.makelist(LabelLocation(address, FIRST));
-        this->false_list = buffer.makelist(LabelLocation(address, SECOND));
-        this->reg = "";
+        int address = ctx().buffer.emitCondBranch(this->reg);
+        this->true_list = ctx().buffer.makelist(LabelLocation(address, FIRST));
+        this->false_list = ctx().buffer.makelist(LabelLocation(address, SECOND));
+        this->cond = this->reg;
+        this->reg = Value();
     }
 
-    this->value = "0";
-    
     this->is_call = true;
     this->name = call->name;
 }
 
 void Exp::evaluateBoolToReg()
 {
-    if(this->type != "bool" || this->in_reg())
+    if(this->type != TypeId::BOOL || this->in_reg())
+    {
+        return;
+    }
+
+    if (this->is_const)
     {
+        this->reg = Value::imm(this->const_value);
         return;
     }
 
-    string true_label = buffer.genLabel();
-    LabelLocation true_jump_to_phi_loc = buffer.emitJump();
-    buffer.bpatch(this->true_list, true_label);
+    /** A single branch on cond that was just emitted (not an and / or chain): its
+     * value is cond itself (or its negation when a 'not' swapped the lists),
+     * so the branch is dropped instead of jumping to a phi */
+    int last = ctx().buffer.nextAddress() - 1;
+    if (this->cond.valid() && this->true_list.size() == 1 && this->false_list.size() == 1 &&
+        this->true_list[0].first == last && this->false_list[0].first == last)
+    {
+        ctx().buffer.dropCode(last, last + 1);
+        bool negated = (this->true_list[0].second == SECOND);
+        this->reg = negated ? ctx().buffer.emitBinary(BinaryOp::XOR, TypeId::BOOL, this->cond, Value::imm(1)) : this->cond;
+        this->true_list.clear();
+        this->false_list.clear();
+        return;
+    }
 
-    string false_label = buffer.genLabel();
-    LabelLocation false_jump_to_phi_loc = buffer.emitJump();
-    buffer.bpatch(this->false_list, false_label);
+    LabelId true_label = ctx().buffer.genLabel();
+    LabelLocation true_jump_to_phi_loc = ctx().buffer.emitJump();
+    ctx().buffer.bpatch(this->true_list, true_label);
 
-    string phi_label = buffer.genLabel();
-    vector<LabelLocation> phi_jump_locations = buffer.merge(
-        buffer.makelist(true_jump_to_phi_loc),
-        buffer.makelist(false_jump_to_phi_loc));
+    LabelId false_label = ctx().buffer.genLabel();
+    LabelLocation false_jump_to_phi_loc = ctx().buffer.emitJump();
+    ctx().buffer.bpatch(this->false_list, false_label);
 
-    buffer.bpatch(phi_jump_locations, phi_label);
+    LabelId phi_label = ctx().buffer.genLabel();
+    vector<LabelLocation> phi_jump_locations = ctx().buffer.merge(
+        ctx().buffer.makelist(true_jump_to_phi_loc),
+        ctx().buffer.makelist(false_jump_to_phi_loc));
 
-    this->reg = buffer.genReg();
-    buffer.emit(this->reg + " = phi i32 [1, %" + true_label + "], [0, %" + false_label + "]");
-}
+    ctx().buffer.bpatch(phi_jump_locations, phi_label);
 
-string Exp::getArgReg(int offset, string currentArgType)
-{
-    string reg = "%" + std::to_string((-1 - offset));
-    if (currentArgType == "int" || currentArgType == "string")
-    {
-        /* no need for conversion if the arg is interger or string*/
-        return reg;
-    }
-    return buffer.paddReg(reg, currentArgType);
+    this->reg = ctx().buffer.emitPhi(TypeId::BOOL, {{TypeId::BOOL, Value::imm(1), true_label},
+                                              {TypeId::BOOL, Value::imm(0), false_label}});
 }
 
 ExpList::ExpList(Exp *expression)
@@ -390,12 +573,11 @@ ExpList::ExpList(Exp *additional_exp, ExpList *current_list)
     this->exp_list.insert(this->exp_list.begin(), additional_exp);
 }
 
-Call::Call(const string name, ExpList *exp_list)
+Call::Call(const NameId name, ExpList *exp_list)
 {
-    if (!symbolTable.isFuncSymbolNameExist(name))
+    if (!ctx().symbolTable.isFuncSymbolNameExist(name))
     {
-        output::errorUndefFunc(yylineno, name);
-        exit(1);
+        output::errorUndefFunc(ctx().line(), ctx().nameInterner.str(name));
     }
 
     if (exp_list == nullptr)
@@ -403,33 +585,32 @@ Call::Call(const string name, ExpList *exp_list)
         exp_list = new ExpList();
     }
 
-    vector<pair<string, int>> ret_types = symbolTable.getLegalCallReturnTypes(name, exp_list->getTypesVector());
+    const vector<PSymbol> &overloads = ctx().symbolTable.resolveCall(name, exp_list->getTypesVector());
 
-    if (ret_types.empty())
+    if (overloads.empty())
     {
-        output::errorPrototypeMismatch(yylineno, name);
-        exit(1);
+        output::errorPrototypeMismatch(ctx().line(), ctx().nameInterner.str(name));
     }
 
-    if (ret_types.size() > 1)
+    if (overloads.size() > 1)
     {
-        output::errorAmbiguousCall(yylineno, name);
-        exit(1);
+        output::errorAmbiguousCall(ctx().line(), ctx().nameInterner.str(name));
     }
 
     this->name = name;
     this->exp_list = *exp_list;
-    this->return_type = ret_types[0].first;
-    this->version = ret_types[0].second;
-    this->name_with_version = this->name + "_" + std::to_string(this->version);
-    string args = getLlvmArgs();
+    this->return_type = overloads[0]->m_returnType;
+    this->version = overloads[0]->m_version;
+    this->parameters = &overloads[0]->m_parameters;
+    this->name_with_version = ctx().nameInterner.str(this->name) + "_" + std::to_string(this->version);
+    vector<ExtraOperand> args = getLlvmArgs();
 
     /* print the correct call according to function*/
-    if (this->return_type == "void")
+    if (this->return_type == TypeId::VOID)
     {
         callVoidFunction(args);
     }
-    else if (this->return_type == "bool")
+    else if (this->return_type == TypeId::BOOL)
     {
         callBoolFunction(args);
     }
@@ -442,49 +623,42 @@ Call::Call(const string name, ExpList *exp_list)
 /**
  * emit the call command for printf function
  */
-void Call::callVoidFunction(string args)
+void Call::callVoidFunction(const vector<ExtraOperand> &args)
 {
     /* the return type is void*/
-    buffer.emit("call void @" + this->name_with_version + "(" + args + ")");
+    ctx().buffer.emitCall(TypeId::VOID, this->name_with_version, args);
 }
 
 /**
  * emit the call command for printi function
  */
-void Call::callBoolFunction(string args)
+void Call::callBoolFunction(const vector<ExtraOperand> &args)
 {
-    /* generate a fresh reg for this function call result*/
-    string tmp_reg = buffer.genReg();
     /* call the function and insert the result into this->reg*/
-    buffer.emit(tmp_reg + " = call i1 @" + this->name_with_version + "(" + args + ")");
-    this->reg = tmp_reg;
+    this->reg = ctx().buffer.emitCall(TypeId::BOOL, this->name_with_version, args);
 }
 
 /**
  * emit the call command for the function
  */
-void Call::callFunction(string args)
+void Call::callFunction(const vector<ExtraOperand> &args)
 {
-    this->reg = buffer.genReg();
     /* return type is i32 or i8 or it's a bug*/
-    string type_code = buffer.typeCode(this->return_type);
-    assert(type_code == "i32" || type_code == "i8");
-    buffer.emit(this->reg + " = call " + type_code + " @" + this->name_with_version + "(" + args + ")");
-    /* enter the correct result to a new reg*/
-    this->reg = (type_code == "i32") ? this->reg : buffer.paddReg(this->reg, this->return_type);
+    assert(this->return_type == TypeId::INT || this->return_type == TypeId::BYTE);
+    this->reg = ctx().buffer.emitCall(this->return_type, this->name_with_version, args);
 }
 
 /**
- * get the arguments of the function as a single string
- * in the LLVM syntax
- * @return string - the LLVM arguments of the function
+ * get the arguments of the function as call operands
+ * (converted to the LLVM types of the parameters)
+ * @return vector<ExtraOperand> - the LLVM arguments of the function
  */
-string Call::getLlvmArgs()
+vector<ExtraOperand> Call::getLlvmArgs()
 {
-    string result = "";
+    vector<ExtraOperand> result;
     /* get the parameters of the function as were written in the decleration*/
     /* foo(int, byte, bool); --> foo(int int int);*/
-    vector<string> parameters = symbolTable.getFuncParameters(this->name, this->version);
+    const vector<TypeId> &parameters = *this->parameters;
     assert(parameters.size() == exp_list.exp_list.size());
     int number_of_params = parameters.size();
 
@@ -493,32 +667,23 @@ string Call::getLlvmArgs()
         /* is this a direct ptr or copy c'tor?*/
         Exp *tmp = exp_list.exp_list[i];
 
-        string new_reg = tmp->reg;
+        Value new_reg = tmp->reg;
 
         /* check for type mismatch between types*/
-        if (parameters[i] == "bool" || parameters[i] == "byte")
+        if (parameters[i] != TypeId::BOOL && parameters[i] != TypeId::STRING)
         {
-            /* bools are stored after phi in i32*/
-            /* bytes are stored in i32 anyways*/
-            new_reg = buffer.convertTypes("int", parameters[i], tmp->reg);
-        }
-        /* add this expression's type*/
-        result += buffer.typeCode(parameters[i]);
-        result += " ";
-        /* add this expression's reg*/
-        result += new_reg;
-        /* if i is not the last one, add a comma*/
-        if (i != exp_list.exp_list.size() - 1)
-        {
-            result += ", ";
+            /* a byte passed as an int is widened*/
+            new_reg = tmp->numericReg(parameters[i]);
         }
+        /* add this expression's type and reg*/
+        result.push_back({parameters[i], new_reg, NO_LABEL});
     }
     return result;
 }
 
-vector<string> ExpList::getTypesVector() const
+vector<TypeId> ExpList::getTypesVector() const
 {
-    vector<string> args;
+    vector<TypeId> args;
 
     for (auto &exp : this->exp_list)
     {
@@ -546,9 +711,9 @@ FormalList::FormalList(const FormalDecl *formal_decl, const FormalList *current_
     this->formal_list.insert(this->formal_list.begin(), *formal_decl);
 }
 
-vector<string> FormalList::getTypesVector() const
+vector<TypeId> FormalList::getTypesVector() const
 {
-    vector<string> arg_types;
+    vector<TypeId> arg_types;
 
     for (auto &formal : this->formal_list)
     {
@@ -558,9 +723,9 @@ vector<string> FormalList::getTypesVector() const
     return arg_types;
 }
 
-vector<string> FormalList::getNamesVector() const
+vector<NameId> FormalList::getNamesVector() const
 {
-    vector<string> arg_names;
+    vector<NameId> arg_names;
 
     for (auto &formal : this->formal_list)
     {
@@ -575,25 +740,22 @@ void Statements::enforceReturn()
     if (this->return_in_last)
         return;
 
-    string return_type_c = symbolTable.getClosestReturnType();
-    if (return_type_c != "void")
+    TypeId return_type_c = ctx().symbolTable.getClosestReturnType();
+    if (return_type_c != TypeId::VOID)
     {
-        string return_type_llvm = buffer.typeCode(return_type_c);
-        string default_val_llvm = buffer.getDefaultValue(return_type_c);
-
-        buffer.emit("ret " + return_type_llvm + " " + default_val_llvm);
+        ctx().buffer.emitReturn(return_type_c, Value::imm(0));
         return;
     }
 
-    buffer.emit("ret void");
+    ctx().buffer.emitReturn(TypeId::VOID);
     return;
 }
 
 Statements::Statements(Statement *statement)
 {
     /* merge the lists of the Statements and Statement*/
-    this->break_list = buffer.merge(this->break_list, statement->break_list);
-    this->cont_list = buffer.merge(this->cont_list, statement->cont_list);
+    this->break_list = ctx().buffer.merge(this->break_list, statement->break_list);
+    this->cont_list = ctx().buffer.merge(this->cont_list, statement->cont_list);
     this->return_in_last = statement->return_statement;
     delete statement;
 }
@@ -601,8 +763,8 @@ Statements::Statements(Statement *statement)
 Statements::Statements(Statements *statements, Statement *statement) : Node(), cont_list(), break_list()
 {
     /* merge the lists of the Statements and Statement that were given into this one*/
-    this->break_list = buffer.merge(statements->break_list, statement->break_list);
-    this->cont_list = buffer.merge(statements->cont_list, statement->cont_list);
+    this->break_list = ctx().buffer.merge(statements->break_list, statement->break_list);
+    this->cont_list = ctx().buffer.merge(statements->cont_list, statement->cont_list);
     this->return_in_last = statement->return_statement;
 
     delete statement;
@@ -613,68 +775,62 @@ Statements::Statements(Statements *statements, Statement *statement) : Node(), c
 Statement::Statement(Type *type, Id *id) : Node(), break_list(), cont_list()
 {
     /* check if symbol already exists with this name*/
-    if (symbolTable.isSymbolExist(id->name))
+    if (ctx().symbolTable.isSymbolExist(id->name))
     {
-        output::errorDef(yylineno, id->name);
-        exit(1);
+        output::errorDef(ctx().line(), ctx().nameInterner.str(id->name));
     }
     /* insert the symbol to the table*/
-    int offset = symbolTable.insertSymbol(id->name, type->type);
+    int offset = ctx().symbolTable.insertSymbol(id->name, type->type);
     this->type = type->type;
     /******************* code generation: *****************************/
     /* store default value within this variable on the stack*/
-    buffer.storeVariable(symbolTable.getCurrentRbp(), offset, buffer.getDefaultValue(this->type));
+    ctx().buffer.storeVariable(offset, type->type, Value::imm(0));
 }
 
 /* Type ID ASSIGN Exp SC --- int x = 6*/
 Statement::Statement(Type *type, Id *id, Exp *exp) : Node(), break_list(), cont_list()
 {
     /* check if symbol already exists*/
-    if (symbolTable.isSymbolExist(id->name))
+    if (ctx().symbolTable.isSymbolExist(id->name))
     {
-        output::errorDef(yylineno, id->name);
-        exit(1);
+        output::errorDef(ctx().line(), ctx().nameInterner.str(id->name));
     }
     /* check for type mismatch in the assignment*/
     if (SymbolTable::checkTypes(type->type, exp->type) == false)
     {
         /* different types is illegal*/
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
     /* if we got here this statement is ok. insert the new symbol*/
-    int offset = symbolTable.insertSymbol(id->name, type->type);
+    int offset = ctx().symbolTable.insertSymbol(id->name, type->type);
     /******************* code generation: *****************************/
-    assignCode(exp, offset);
+    assignCode(exp, offset, type->type);
 }
 
 /* ID ASSIGN Exp SC*/
 Statement::Statement(Id *id, Exp *exp) : Node(), break_list(), cont_list()
 {
     /* if the symbol doesn't exist it is illegal to assign*/
-    if (symbolTable.isSymbolExist(id->name) == false)
+    if (ctx().symbolTable.isSymbolExist(id->name) == false)
     {
-        output::errorUndef(yylineno, id->name);
-        exit(1);
+        output::errorUndef(ctx().line(), ctx().nameInterner.str(id->name));
     }
     /* if this symbol exists but a function, it is illegal to assign*/
-    if (symbolTable.isFuncSymbolNameExist(id->name))
+    if (ctx().symbolTable.isFuncSymbolNameExist(id->name))
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
     /* check for type assignment mismatch*/
-    if (SymbolTable::checkTypes(symbolTable.getSymbolType(id->name), exp->type) == false)
+    if (SymbolTable::checkTypes(ctx().symbolTable.getSymbolType(id->name), exp->type) == false)
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
     /* assignment is legal*/
     /******************* code generation: *****************************/
-    int offset = symbolTable.getSymbolOffset(id->name);
+    int offset = ctx().symbolTable.getSymbolOffset(id->name);
     /* the case of an assignemnt to a parameter isn't supposed to be checked*/
     assert(offset >= 0);
-    assignCode(exp, offset);
+    assignCode(exp, offset, ctx().symbolTable.getSymbolType(id->name));
 }
 
 /* Call SC*/
@@ -691,39 +847,36 @@ Statement::Statement(const string operation) : Node(), break_list(), cont_list()
     if (operation == "return")
     {
         /* check for the return type (has to be void)*/
-        if (symbolTable.getClosestReturnType() != "void")
+        if (ctx().symbolTable.getClosestReturnType() != TypeId::VOID)
         {
-            output::errorMismatch(yylineno);
-            exit(1);
+            output::errorMismatch(ctx().line());
         }
         /******************* code generation: *****************************/
         this->return_statement = true;
-        buffer.emit("ret void");
+        ctx().buffer.emitReturn(TypeId::VOID);
     }
     else
     {
         /* if we're not in a loop, this is unexpected*/
-        if (symbolTable.isWithinLoop() == false)
+        if (ctx().symbolTable.isWithinLoop() == false)
         {
             /* print according to the operation*/
             if (operation == "break")
-                output::errorUnexpectedBreak(yylineno);
+                output::errorUnexpectedBreak(ctx().line());
             else
-                output::errorUnexpectedContinue(yylineno);
-            /*exit anyways*/
-            exit(1);
+                output::errorUnexpectedContinue(ctx().line());
         }
         /* 'break' or 'continue' both require a jump that will later be backpatched*/
-        int address = buffer.emit("br label @");
+        int address = ctx().buffer.emitJump().first;
         if (operation == "break")
         {
             /* create break list for this break command*/
-            this->break_list = buffer.makelist(LabelLocation(address, FIRST));
+            this->break_list = ctx().buffer.makelist(LabelLocation(address, FIRST));
         }
         else
         { /* the operation is continue*/
             /* create continue list for this continue command*/
-            this->cont_list = buffer.makelist(LabelLocation(address, FIRST));
+            this->cont_list = ctx().buffer.makelist(LabelLocation(address, FIRST));
         }
     }
 }
@@ -731,16 +884,14 @@ Statement::Statement(const string operation) : Node(), break_list(), cont_list()
 /* RETURN Exp SC*/
 Statement::Statement(Exp *exp) : Node(), break_list(), cont_list()
 {
-    if(!exp->is_call && symbolTable.isFuncSymbolNameExist(exp->name))
+    if(!exp->is_call && ctx().symbolTable.isFuncSymbolNameExist(exp->name))
     {
-        output::errorUndef(yylineno, exp->name);
-        exit(1);
+        output::errorUndef(ctx().line(), ctx().nameInterner.str(exp->name));
     }
     /* check for the return type (has to be the same as exp)*/
-    if (!symbolTable.checkTypes(symbolTable.getClosestReturnType(), exp->type))
+    if (!ctx().symbolTable.checkTypes(ctx().symbolTable.getClosestReturnType(), exp->type))
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
     /******************* code generation: *****************************/
     this->return_statement = true;
@@ -754,8 +905,8 @@ Statement::Statement() : Node(), break_list(), cont_list()
 
 void Statement::mergeLists(Statements *statements)
 {
-    break_list = buffer.merge(break_list, statements->break_list);
-    cont_list = buffer.merge(cont_list, statements->cont_list);
+    break_list = ctx().buffer.merge(break_list, statements->break_list);
+    cont_list = ctx().buffer.merge(cont_list, statements->cont_list);
     delete statements;
 }
 
@@ -763,67 +914,106 @@ void Statement::mergeLists(Statements *statements)
 Statement::Statement(Exp *exp, MarkerM *m, Statement *statement) : Node(), break_list(), cont_list()
 {
     /* exp is a boolean, no need to check*/
+    if (exp->is_const)
+    {
+        if (exp->const_value)
+        {
+            /* the condition falls through to the statement, no label is needed*/
+            ctx().buffer.dropCode(m->start, m->end);
+            this->break_list = statement->break_list;
+            this->cont_list = statement->cont_list;
+        }
+        else
+        {
+            /* the statement is dead, and so are its breaks and continues*/
+            ctx().buffer.dropCode(m->start, ctx().buffer.nextAddress());
+        }
+        return;
+    }
+
     /* merge the break and continue lists with the ones of the statement*/
-    this->break_list = buffer.merge(break_list, statement->break_list);
-    this->cont_list = buffer.merge(cont_list, statement->cont_list);
+    this->break_list = ctx().buffer.merge(break_list, statement->break_list);
+    this->cont_list = ctx().buffer.merge(cont_list, statement->cont_list);
 
     /**
      * backpatch the true_list of the expression (the condition) with the stmts
      * within the "if" scope
      * */
-    buffer.bpatch(exp->true_list, m->quad);
+    ctx().buffer.bpatch(exp->true_list, m->quad);
 
     /* generate the label that states the "if" condition is false, and emit it*/
-    string falseLabel = buffer.genLabel();
+    LabelId falseLabel = ctx().buffer.genLabel();
     /* backpatch the false and next list of the expression (the condition)*/
-    buffer.bpatch(exp->false_list, falseLabel);
-    buffer.bpatch(exp->next_list, falseLabel);
+    ctx().buffer.bpatch(exp->false_list, falseLabel);
+    ctx().buffer.bpatch(exp->next_list, falseLabel);
 }
 
 /* IF LPAREN Exp RPAREN M Statement ELSE N M Statement*/
-Statement::Statement(Exp *exp, MarkerM *trueCondition, Statement *ifStatement, MarkerM *falseCondition, Statement *elseStatement) : Node(), break_list(), cont_list()
+Statement::Statement(Exp *exp, MarkerM *trueCondition, Statement *ifStatement, MarkerN *skipElse, MarkerM *falseCondition, Statement *elseStatement) : Node(), break_list(), cont_list()
 {
     /* exp is a boolean, no need to check*/
+    if (exp->is_const)
+    {
+        /* keep only the block that is taken, entered by falling through the condition*/
+        if (exp->const_value)
+        {
+            ctx().buffer.dropCode(skipElse->start, ctx().buffer.nextAddress());
+            ctx().buffer.dropCode(trueCondition->start, trueCondition->end);
+            this->cont_list = ifStatement->cont_list;
+            this->break_list = ifStatement->break_list;
+        }
+        else
+        {
+            ctx().buffer.dropCode(trueCondition->start, falseCondition->end);
+            this->cont_list = elseStatement->cont_list;
+            this->break_list = elseStatement->break_list;
+        }
+        return;
+    }
+
     /**
      * merge the continue and break lists of both statements, since when this if-else is within a loop,
      * both continue and break need to jump to the same location.
      */
-    this->cont_list = buffer.merge(ifStatement->cont_list, elseStatement->cont_list);
-    this->break_list = buffer.merge(ifStatement->break_list, elseStatement->break_list);
+    this->cont_list = ctx().buffer.merge(ifStatement->cont_list, elseStatement->cont_list);
+    this->break_list = ctx().buffer.merge(ifStatement->break_list, elseStatement->break_list);
     /* backpatch the true list of the condition to jump to the inner part of the if block*/
-    buffer.bpatch(exp->true_list, trueCondition->quad);
+    ctx().buffer.bpatch(exp->true_list, trueCondition->quad);
     /* backpatch the false list of the condition to jump to the inner part of the else block*/
-    buffer.bpatch(exp->false_list, falseCondition->quad);
+    ctx().buffer.bpatch(exp->false_list, falseCondition->quad);
     /* the next operation to perform is a new label, outside of both if and else blocks*/
-    string outLabel = buffer.genLabel();
-    buffer.bpatch(exp->next_list, outLabel);
+    LabelId outLabel = ctx().buffer.genLabel();
+    ctx().buffer.bpatch(exp->next_list, outLabel);
 }
 
 /* WHILE LPAREN M Exp RPAREN M Statement*/
 Statement::Statement(MarkerM *loopCondition, Exp *exp, MarkerM *loopStmts, Statement *statement) : Node(), break_list(), cont_list()
 {
     /* exp is a boolean, no need to check*/
-    /* emit the correct label for the condition of the loop*/
-    string loopLabel = loopCondition->quad;
-    if (loopLabel[0] != '%' && loopLabel[0] != '@')
+    if (exp->is_const && !exp->const_value)
     {
-        buffer.emit("br label %" + loopLabel);
+        /* the loop is never entered, the condition has no code either*/
+        ctx().buffer.dropCode(loopCondition->start, ctx().buffer.nextAddress());
+        return;
     }
-    else
+    if (exp->is_const)
     {
-        buffer.emit("br label " + loopLabel);
+        /* while (true): the statements directly follow the loop label*/
+        ctx().buffer.dropCode(loopStmts->start, loopStmts->end);
     }
+    /* emit the correct label for the condition of the loop*/
+    ctx().buffer.emitBranch(loopCondition->quad);
     /* emit another label for getting out of the loop*/
-    string outLabel = buffer.genLabel();
+    LabelId outLabel = ctx().buffer.genLabel();
     /* if the condition is true, bp to jump to the statements*/
-    buffer.bpatch(exp->true_list, loopStmts->quad);
+    ctx().buffer.bpatch(exp->true_list, loopStmts->quad);
     /* otherwise, jump out of the loop*/
-    buffer.bpatch(exp->false_list, outLabel);
-    buffer.bpatch(exp->next_list, outLabel);
+    ctx().buffer.bpatch(exp->false_list, outLabel);
+    ctx().buffer.bpatch(exp->next_list, outLabel);
     /* the breaks within the loop should go out of the loop*/
-    buffer.bpatch(statement->break_list, outLabel);
+    ctx().buffer.bpatch(statement->break_list, outLabel);
     /* the continues within the loop should go back to the condition*/
-    buffer.bpatch(statement->cont_list, loopCondition->quad);
+    ctx().buffer.bpatch(statement->cont_list, loopCondition->quad);
 }
 
 /* methods for creating the code */
@@ -832,15 +1022,22 @@ Statement::Statement(MarkerM *loopCondition, Exp *exp, MarkerM *loopStmts, State
  * creates and emits the code for storing a variable within a reg into an address on the stack.
  * @note: if the exp given is NOT an id variable, Aviv wrote evaluation function to insert its value in a reg
  * @param exp the expression to insert to the stack
- * @param offset the offset after the rbp that this variable needs to be inserted to
+ * @param offset the offset of the variable in the function's frame
+ * @param varType the type of the variable
  */
-void Statement::assignCode(Exp *exp, int offset)
+void Statement::assignCode(Exp *exp, int offset, TypeId varType)
 {
-    if (!exp->in_reg())
+    Value value;
+    if (varType == TypeId::BOOL)
     {
         exp->evaluateBoolToReg();
+        value = exp->reg;
+    }
+    else
+    {
+        value = exp->numericReg(varType);
     }
-    buffer.storeVariable(symbolTable.getCurrentRbp(), offset, exp->reg);
+    ctx().buffer.storeVariable(offset, varType, value);
 }
 
 /**
@@ -851,23 +1048,21 @@ void Statement::assignCode(Exp *exp, int offset)
 void Statement::returnCode(Exp *exp)
 {
     /* convert return type to LLVM syntax*/
-    string returnType = buffer.typeCode(symbolTable.getClosestReturnType());
+    TypeId returnTypeId = ctx().symbolTable.getClosestReturnType();
 
     /* make sure exp->reg has the correct result*/
     if (!exp->in_reg())
     {
-        assert(exp->type == "bool");
+        assert(exp->type == TypeId::BOOL);
         exp->evaluateBoolToReg();
     }
-    /* if the type is not i32, trunc the result to be in the correct size*/
-    if (returnType != "i32")
+    if (returnTypeId != TypeId::BOOL)
     {
-        string new_reg = buffer.genReg();
-        buffer.emit(new_reg + " = trunc i32 " + exp->reg + " to " + returnType);
-        exp->reg = new_reg;
+        /* a byte returned from an int function is widened*/
+        exp->reg = exp->numericReg(returnTypeId);
     }
     /* emit the return command*/
-    buffer.emit("ret " + returnType + " " + exp->reg);
+    ctx().buffer.emitReturn(returnTypeId, exp->reg);
 }
 
 FuncDecl::FuncDecl(const Override *override_node,
@@ -876,48 +1071,44 @@ FuncDecl::FuncDecl(const Override *override_node,
                    const FormalList *formals_node)
 {
     bool override = override_node->override;
-    string ret_type = ret_type_node->type;
-    string name = id_node->name;
-    vector<string> arg_types = formals_node->getTypesVector();
+    TypeId ret_type = ret_type_node->type;
+    NameId name = id_node->name;
+    vector<TypeId> arg_types = formals_node->getTypesVector();
 
-    if (symbolTable.isFuncSymbolNameExist(name))
+    if (ctx().symbolTable.isFuncSymbolNameExist(name))
     {
         /* Check for double definition of the function*/
         /* if it's not double defined, make sure it's override*/
-        if (!symbolTable.isSymbolOverride(name))
+        if (!ctx().symbolTable.isSymbolOverride(name))
         {
             if (!override)
             {
-                output::errorDef(yylineno, name);
-                exit(1);
+                output::errorDef(ctx().line(), ctx().nameInterner.str(name));
             }
 
-            output::errorFuncNoOverride(yylineno, name);
-            exit(1);
+            output::errorFuncNoOverride(ctx().line(), ctx().nameInterner.str(name));
         }
 
         // Symbol already declared as override
 
         if (!override)
         {
-            output::errorOverrideWithoutDeclaration(yylineno, name);
-            exit(1);
+            output::errorOverrideWithoutDeclaration(ctx().line(), ctx().nameInterner.str(name));
         }
 
-        vector<string> ret_types = symbolTable.getFuncDeclReturnTypes(name, arg_types);
+        vector<TypeId> ret_types = ctx().symbolTable.getFuncDeclReturnTypes(name, arg_types);
         for (auto &match_type : ret_types)
         {
             if (match_type == ret_type)
             {
-                output::errorDef(yylineno, name);
-                exit(1);
+                output::errorDef(ctx().line(), ctx().nameInterner.str(name));
             }
         }
     }
 
-    if (name == "main")
+    if (ctx().nameInterner.str(name) == "main")
     {
-        if (ret_type != "void" || arg_types.size() > 0)
+        if (ret_type != TypeId::VOID || arg_types.size() > 0)
         {
             // output::???(yylineno, name);
             // exit(1);
@@ -925,63 +1116,40 @@ FuncDecl::FuncDecl(const Override *override_node,
 
         if (override)
         {
-            output::errorMainOverride(yylineno);
-            exit(1);
+            output::errorMainOverride(ctx().line());
         }
     }
 
-    int version = symbolTable.insertFuncSymbol(name, ret_type, override, arg_types);
+    int version = ctx().symbolTable.insertFuncSymbol(name, ret_type, override, arg_types);
 
     this->name = name;
     this->type = ret_type;
     this->args_count = arg_types.size();
 
-    symbolTable.pushScope(false, ret_type);
+    ctx().symbolTable.pushScope(false, ret_type);
     /* get the names of the args*/
-    vector<string> arg_names = formals_node->getNamesVector();
+    vector<NameId> arg_names = formals_node->getNamesVector();
     /* insert them as args (i.e. with negative offsets)*/
-    string errorName = symbolTable.insertArgs(arg_types, arg_names);
-    if (errorName != "")
+    NameId errorName = ctx().symbolTable.insertArgs(arg_types, arg_names);
+    if (errorName != NO_NAME)
     {
-        output::errorDef(yylineno, errorName);
-        exit(1);
+        output::errorDef(ctx().line(), ctx().nameInterner.str(errorName));
     }
 
-    buffer.emit("define " + buffer.typeCode(ret_type) + " " + funcNameCode(name, version) + formalsCode(arg_types));
-    buffer.emitLeftBrace();
-    symbolTable.setCurrentRbp(buffer.allocFunctionRbp());
+    ctx().buffer.emitFunctionBegin(ret_type, funcNameCode(name, version), arg_types);
 }
 
-string FuncDecl::funcNameCode(string name, int version)
+string FuncDecl::funcNameCode(NameId name, int version)
 {
-    string func_name = "@" + name;
-    if (name != "main")
+    const string &name_str = ctx().nameInterner.str(name);
+    string func_name = name_str;
+    if (name_str != "main")
     {
         func_name += "_" + std::to_string(version);
     }
     return func_name;
 }
 
-string FuncDecl::formalsCode(vector<string> formals_types)
-{
-    string formals_str = "(";
-
-    for (string formal_type : formals_types)
-    {
-        if (formal_type == "string")
-            formals_str += "i8*";
-        else if (formal_type == "bool")
-            formals_str += "i1";
-        else if (formal_type == "int")
-            formals_str += "i32";
-        else if (formal_type == "byte")
-            formals_str += "i8";
-        formals_str += ", ";
-    }
-
-    return formals_str.substr(0, formals_str.size() - 2) + ")";
-}
-
 MarkerM::MarkerM()
 {
     /** Although in the lacture's IR line numbers were used for backpatching-
@@ -990,25 +1158,27 @@ MarkerM::MarkerM()
      *  we generate a fresh label, emit it and save it as quad.
      */
 
-    this->quad = buffer.genLabel();
+    this->start = ctx().buffer.nextAddress();
+    this->quad = ctx().buffer.genLabel();
+    this->end = ctx().buffer.nextAddress();
 }
 
 MarkerN::MarkerN()
 {
-    int address = buffer.emit("br label @");
-    this->next_list = buffer.makelist(LabelLocation(address, FIRST));
+    int address = ctx().buffer.emitJump().first;
+    this->start = address;
+    this->next_list = ctx().buffer.makelist(LabelLocation(address, FIRST));
 }
 
 void isBool(Exp *exp)
 {
-    if (exp->type != "bool")
+    if (exp->type != TypeId::BOOL)
     {
-        output::errorMismatch(yylineno);
-        exit(1);
+        output::errorMismatch(ctx().line());
     }
 }
 
 void mergeNextList(Exp *exp, MarkerN *n)
 {
-    exp->next_list = buffer.merge(n->next_list, exp->next_list);
+    exp->next_list = ctx().buffer.merge(n->next_list, exp->next_list);
 }
@@ -5,6 +5,9 @@
 #include <iostream>
 #include <assert.h>
 #include "bp.hpp"
+#include "arena.hpp"
+#include "types.hpp"
+#include "interner.hpp"
 
 using std::string;
 using std::vector;
@@ -12,22 +15,32 @@ using std::vector;
 class Node
 {
 public:
-    string type;
+    TypeId type;
 
-    Node(const string type = "") : type(type) {}
+    Node(const TypeId type = TypeId::NONE) : type(type) {}
 
     Node(const Node &node) : type(node.type) {}
 
     virtual ~Node() = default;
+
+    /* all of the nodes are allocated in the nodeArena and released by it*/
+    static void *operator new(size_t size);
+
+    static void operator delete(void *ptr);
 };
 #define YYSTYPE Node *
+/* a pointer, so bison may grow its stack (up to YYMAXDEPTH) instead of failing deep nesting at 200 entries*/
+#define YYSTYPE_IS_TRIVIAL 1
 
 class MarkerM : public Node
 {
 public:
     MarkerM();
     virtual ~MarkerM() = default;
-    string quad;
+    LabelId quad;
+    /* the instructions of the marker (the label and the jump to it) are in [start, end)*/
+    int start;
+    int end;
 };
 
 class MarkerN : public Node
@@ -36,14 +49,16 @@ public:
     MarkerN();
     virtual ~MarkerN() = default;
     vector<LabelLocation> next_list;
+    /* the address of the jump over the else block*/
+    int start;
 };
 
 class Id : public Node
 {
 public:
-    string name;
+    NameId name;
 
-    Id(const string name) : name(name) {}
+    Id(const NameId name) : name(name) {}
 
     virtual ~Id() = default;
 };
@@ -51,7 +66,7 @@ public:
 class Type : public Node
 {
 public:
-    Type(const string type) : Node(type) {}
+    Type(const TypeId type) : Node(type) {}
 
     virtual ~Type() = default;
 };
@@ -61,7 +76,7 @@ class RetType : public Node
 public:
     RetType(const Type *type_node) : Node(type_node->type) {}
 
-    RetType(const string type) : Node(type) { assert(type == "void"); }
+    RetType(const TypeId type) : Node(type) { assert(type == TypeId::VOID); }
 
     virtual ~RetType() = default;
 };
@@ -137,36 +152,49 @@ class Exp : public Node
 private:
     const int MAX_BYTE = 255;
 
-    bool isNumericExp(const Exp *exp) { return (exp->type == "byte" || exp->type == "int"); }
+    bool isNumericExp(const Exp *exp) { return ::isNumericType(exp->type); }
 
-    bool isNumericType(const Type *exp) { return (exp->type == "byte" || exp->type == "int"); }
+    bool isNumericType(const Type *exp) { return ::isNumericType(exp->type); }
 
-    bool isBooleanExp(const Exp *exp) { return (exp->type == "bool"); }
+    bool isBooleanExp(const Exp *exp) { return (exp->type == TypeId::BOOL); }
 
-    string getArgReg(int offset, string currentArgType);
+    /* the expression is the constant 'value' - it is used as an immediate and no code is emitted*/
+    void setConst(long long value);
 
-    string loadGetVar(int offset);
+    /** the bool expression is known to be 'value'. A known bool emits no code and has
+     * no true / false lists, the control just falls through it*/
+    void setKnownBool(bool value);
+
+    /* copy the value, the reg and the lists of exp*/
+    void copyFrom(const Exp *exp);
 
 public:
-    string value;
-    string reg;
-    bool in_reg() { return reg != ""; };
-    string code;
+    Value reg;
+    bool in_reg() { return reg.valid(); };
+    /* the value of a number / bool expression that is known at compile time*/
+    bool is_const = false;
+    long long const_value = 0;
+    /* a number literal (possibly cast), only these are range checked when cast to a byte*/
+    bool is_literal = false;
     vector<LabelLocation> true_list;
     vector<LabelLocation> false_list;
+    /* the i1 that the single branch of a comparison / bool variable / bool call is on,
+     * so the value can be taken without the control flow*/
+    Value cond;
     vector<LabelLocation> next_list;
     bool is_call = false;
-    string name = "";
+    NameId name = NO_NAME;
 
     Exp(); // for the newly created expressions in this assignment
 
-    Exp(const string type, const string value);
+    Exp(const TypeId type, const string value);
 
-    Exp(const RawNumber *num, const string type);
+    Exp(const RawNumber *num, const TypeId type);
 
     Exp(bool is_not, const Exp *exp);
 
-    string byteMask(string curr_reg);
+    /* the value of this number expression as a 'wanted' (i8 for a byte, i32 for an int)*/
+    Value numericReg(TypeId wanted) const;
 
     Exp(const Exp *left_exp, const BinOp *op, const Exp *right_exp);
 
@@ -181,6 +209,7 @@ public:
 
     Exp(const Call *call);
 
+    /* put the value of a bool expression in reg (an i1)*/
     void evaluateBoolToReg();
 
     virtual ~Exp() = default;
@@ -200,31 +229,33 @@ public:
 
     virtual ~ExpList() = default;
 
-    vector<string> getTypesVector() const;
+    vector<TypeId> getTypesVector() const;
 };
 
 class Call : public Node
 {
 public:
-    string name;
+    NameId name;
     ExpList exp_list;
-    string return_type;
+    TypeId return_type;
     int version;
-    string reg = "";
+    /* the parameter types of the resolved overload (owned by the symbol table)*/
+    const vector<TypeId> *parameters = nullptr;
+    Value reg;
     string name_with_version;
     vector<LabelLocation> true_list = {};
     vector<LabelLocation> false_list = {};
     vector<LabelLocation> next_list = {};
 
-    Call(const string name, ExpList *exp_list = nullptr);
+    Call(const NameId name, ExpList *exp_list = nullptr);
 
-    string getLlvmArgs();
+    vector<ExtraOperand> getLlvmArgs();
 
-    void callVoidFunction(string args);
+    void callVoidFunction(const vector<ExtraOperand> &args);
 
-    void callBoolFunction(string args);
+    void callBoolFunction(const vector<ExtraOperand> &args);
     
-    void callFunction(string args);
+    void callFunction(const vector<ExtraOperand> &args);
 
     virtual ~Call() = default;
 };
@@ -242,7 +273,7 @@ public:
 class FormalDecl : public Node
 {
 public:
-    string name;
+    NameId name;
 
     FormalDecl(const Type *type, const Id *id);
 
@@ -262,8 +293,8 @@ public:
 
     virtual ~FormalList() = default;
 
-    vector<string> getTypesVector() const;
-    vector<string> getNamesVector() const;
+    vector<TypeId> getTypesVector() const;
+    vector<NameId> getNamesVector() const;
 };
 /* FWD declaration*/
 class Statement;
@@ -310,7 +341,7 @@ public:
     /* IF LPAREN Exp RPAREN M Statement*/
     Statement(Exp *exp, MarkerM *m, Statement *statement);
     /* IF LPAREN Exp RPAREN M Statement ELSE N M Statement*/
-    Statement(Exp *exp, MarkerM *trueCondition, Statement *ifStatement, MarkerM *falseCondition, Statement *elseStatement);
+    Statement(Exp *exp, MarkerM *trueCondition, Statement *ifStatement, MarkerN *skipElse, MarkerM *falseCondition, Statement *elseStatement);
     /* WHILE LPAREN M Exp RPAREN M Statement*/
     Statement(MarkerM *loopCondition, Exp *exp, MarkerM *loopStmts, Statement *statement);
 
@@ -318,7 +349,7 @@ public:
 
     /* methods for creating the code */
 
-    void assignCode(Exp *exp, int offset);
+    void assignCode(Exp *exp, int offset, TypeId varType);
 
     void returnCode(Exp *exp);
 };
@@ -326,7 +357,7 @@ public:
 class FuncDecl : public Node
 {
 public:
-    string name;
+    NameId name;
     int args_count;
 
     FuncDecl(const Override *override_node,
@@ -334,8 +365,7 @@ public:
              const Id *id_node,
              const FormalList *formals_node);
 
-    string funcNameCode(string name, int version);
-    string formalsCode(vector<string> formals_types);
+    string funcNameCode(NameId name, int version);
 
     virtual ~FuncDecl() = default;
 };
@@ -0,0 +1,334 @@
+#include "ssa.hpp"
+
+void SSABuilder::run(int functionStart)
+{
+    m_blocks.clear();
+    m_blockOf.clear();
+    m_defs.clear();
+    m_phis.clear();
+    m_incomplete.clear();
+    m_replace.clear();
+
+    buildBlocks(functionStart);
+    m_defs.resize(m_blocks.size());
+    m_incomplete.resize(m_blocks.size());
+
+    for (size_t b = 0; b < m_blocks.size(); b++)
+    {
+        if (!m_blocks[b].reachable)
+            continue;
+        if (!m_blocks[b].sealed)
+        {
+            bool ready = true;
+            for (int pred : m_blocks[b].preds)
+                ready = ready && m_blocks[pred].filled;
+            if (ready)
+                sealBlock(b);
+        }
+        fillBlock(b);
+        m_blocks[b].filled = true;
+        /* seal the successors that were waiting for this block (the loop headers)*/
+        for (int succ : m_blocks[b].succs)
+        {
+            if (m_blocks[succ].sealed)
+                continue;
+            bool ready = true;
+            for (int pred : m_blocks[succ].preds)
+                ready = ready && m_blocks[pred].filled;
+            if (ready)
+                sealBlock(succ);
+        }
+    }
+
+    /* removing a phi can make the phis that use it trivial as well*/
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t phi = 0; phi < m_phis.size(); phi++)
+        {
+            if (!m_phis[phi].removed && tryRemoveTrivialPhi(phi) != m_phis[phi].dst)
+                changed = true;
+        }
+    }
+
+    rewrite(functionStart);
+}
+
+void SSABuilder::buildBlocks(int functionStart)
+{
+    vector<Instruction> &code = m_code.buffer;
+    int end = code.size();
+
+    auto startBlock = [this](LabelId label, int begin) {
+        if (label != NO_LABEL)
+            m_blockOf[label] = m_blocks.size();
+        m_blocks.push_back({label, begin, begin, {}, {}, false, false, false, {}});
+    };
+
+    /* the entry block gets a label of its own, phis may have to name it*/
+    startBlock(m_code.labelCounter++, functionStart + 1);
+    bool open = true;
+    for (int i = functionStart + 1; i < end; i++)
+    {
+        const Instruction &instruction = code[i];
+        if (instruction.op == Opcode::LABEL)
+        {
+            if (open)
+                m_blocks.back().end = i;
+            startBlock(instruction.labels[0], i + 1);
+            open = true;
+            continue;
+        }
+        if (instruction.op == Opcode::NOP)
+            continue;
+        if (!open)
+        {
+            /* code after a terminator without a label - nothing can jump to it*/
+            startBlock(NO_LABEL, i);
+            open = true;
+        }
+        if (instruction.isTerminator())
+        {
+            m_blocks.back().end = i + 1;
+            open = false;
+        }
+    }
+    if (open)
+        m_blocks.back().end = end;
+
+    for (Block &block : m_blocks)
+    {
+        if (block.end <= block.begin)
+            continue;
+        const Instruction &last = code[block.end - 1];
+        int targets = (last.op == Opcode::BR) ? 1 : (last.op == Opcode::COND_BR) ? 2 : 0;
+        for (int t = 0; t < targets; t++)
+        {
+            auto it = m_blockOf.find(last.labels[t]);
+            if (it != m_blockOf.end())
+                block.succs.push_back(it->second);
+        }
+    }
+
+    /* only the reachable blocks are kept, and only they count as predecessors*/
+    vector<int> stack = {0};
+    m_blocks[0].reachable = true;
+    while (!stack.empty())
+    {
+        int b = stack.back();
+        stack.pop_back();
+        for (int succ : m_blocks[b].succs)
+        {
+            /* one predecessor entry per edge, like LLVM counts them*/
+            m_blocks[succ].preds.push_back(b);
+            if (!m_blocks[succ].reachable)
+            {
+                m_blocks[succ].reachable = true;
+                stack.push_back(succ);
+            }
+        }
+    }
+}
+
+void SSABuilder::fillBlock(int block)
+{
+    vector<Instruction> &code = m_code.buffer;
+    for (int i = m_blocks[block].begin; i < m_blocks[block].end; i++)
+    {
+        Instruction &instruction = code[i];
+        if (instruction.op == Opcode::LOAD)
+        {
+            m_replace[instruction.dst.num] = readVariable(instruction.ops[0].num, instruction.type, block);
+            instruction.op = Opcode::NOP;
+            m_removedLoads++;
+        }
+        else if (instruction.op == Opcode::STORE)
+        {
+            writeVariable(instruction.ops[1].num, block, resolve(instruction.ops[0]));
+            instruction.op = Opcode::NOP;
+            m_removedStores++;
+        }
+    }
+}
+
+void SSABuilder::sealBlock(int block)
+{
+    /* completing a phi may add other incomplete phis to the block*/
+    while (!m_incomplete[block].empty())
+    {
+        unordered_map<long long, int> pending;
+        pending.swap(m_incomplete[block]);
+        for (auto &entry : pending)
+        {
+            addPhiOperands(entry.first, entry.second);
+        }
+    }
+    m_blocks[block].sealed = true;
+}
+
+Value SSABuilder::readVariable(long long slot, TypeId type, int block)
+{
+    auto it = m_defs[block].find(slot);
+    if (it != m_defs[block].end())
+    {
+        return it->second;
+    }
+    return readVariableRecursive(slot, type, block);
+}
+
+Value SSABuilder::readVariableRecursive(long long slot, TypeId type, int block)
+{
+    Value value;
+    const vector<int> &preds = m_blocks[block].preds;
+    if (!m_blocks[block].sealed)
+    {
+        /* not all of the predecessors are known yet, complete it when the block is sealed*/
+        int phi = newPhi(block, type);
+        m_incomplete[block][slot] = phi;
+        value = m_phis[phi].dst;
+    }
+    else if (preds.size() == 1)
+    {
+        value = readVariable(slot, type, preds[0]);
+    }
+    else if (preds.empty())
+    {
+        /* read before any store - can't happen for FanC variables, which are initialized*/
+        value = Value::imm(0);
+    }
+    else
+    {
+        /* break the cycles through loops with an operandless phi*/
+        int phi = newPhi(block, type);
+        writeVariable(slot, block, m_phis[phi].dst);
+        value = addPhiOperands(slot, phi);
+    }
+    writeVariable(slot, block, value);
+    return value;
+}
+
+int SSABuilder::newPhi(int block, TypeId type)
+{
+    int phi = m_phis.size();
+    m_phis.push_back({block, type, m_code.genReg(), {}, false});
+    m_blocks[block].phis.push_back(phi);
+    return phi;
+}
+
+Value SSABuilder::addPhiOperands(long long slot, int phi)
+{
+    int block = m_phis[phi].block;
+    TypeId type = m_phis[phi].type;
+    for (int pred : m_blocks[block].preds)
+    {
+        Value value = readVariable(slot, type, pred);
+        m_phis[phi].operands.push_back({type, value, m_blocks[pred].label});
+    }
+    return tryRemoveTrivialPhi(phi);
+}
+
+Value SSABuilder::tryRemoveTrivialPhi(int phi)
+{
+    Value self = m_phis[phi].dst;
+    Value same;
+    for (const ExtraOperand &operand : m_phis[phi].operands)
+    {
+        Value value = resolve(operand.value);
+        if (value == same || value == self)
+            continue;
+        if (same.valid())
+            return self;
+        same = value;
+    }
+    if (!same.valid())
+    {
+        /* the phi only refers to itself, the block is unreachable or the slot is never written*/
+        same = Value::imm(0);
+    }
+    m_phis[phi].removed = true;
+    m_replace[self.num] = same;
+    return same;
+}
+
+Value SSABuilder::resolve(Value value)
+{
+    while (value.kind == Value::REG)
+    {
+        auto it = m_replace.find(value.num);
+        if (it == m_replace.end())
+            break;
+        value = it->second;
+    }
+    return value;
+}
+
+void SSABuilder::rewrite(int functionStart)
+{
+    vector<Instruction> &code = m_code.buffer;
+    vector<ExtraOperand> &extra = m_code.extraOperands;
+    vector<Instruction> function;
+    function.reserve(code.size() - functionStart);
+    function.push_back(code[functionStart]);
+
+    for (size_t b = 0; b < m_blocks.size(); b++)
+    {
+        const Block &block = m_blocks[b];
+        if (!block.reachable)
+            continue;
+
+        Instruction label(Opcode::LABEL);
+        label.labels[0] = block.label;
+        function.push_back(label);
+
+        for (int p : block.phis)
+        {
+            const Phi &phi = m_phis[p];
+            if (phi.removed)
+                continue;
+            Instruction instruction(Opcode::PHI, phi.type);
+            instruction.dst = phi.dst;
+            vector<ExtraOperand> operands = phi.operands;
+            for (ExtraOperand &operand : operands)
+                operand.value = resolve(operand.value);
+            m_code.setExtraOperands(instruction, operands);
+            function.push_back(instruction);
+            m_insertedPhis++;
+        }
+
+        for (int i = block.begin; i < block.end; i++)
+        {
+            Instruction instruction = code[i];
+            if (instruction.op == Opcode::NOP || instruction.op == Opcode::LABEL)
+                continue;
+            instruction.ops[0] = resolve(instruction.ops[0]);
+            instruction.ops[1] = resolve(instruction.ops[1]);
+            vector<ExtraOperand> operands;
+            for (int e = 0; e < instruction.extraCount; e++)
+            {
+                ExtraOperand operand = extra[instruction.extraBegin + e];
+                operand.value = resolve(operand.value);
+                if (instruction.op == Opcode::PHI)
+                {
+                    /* drop the incoming values of the blocks that were removed*/
+                    auto it = m_blockOf.find(operand.label);
+                    if (it == m_blockOf.end() || !m_blocks[it->second].reachable)
+                        continue;
+                }
+                operands.push_back(operand);
+            }
+            if (instruction.extraCount > 0)
+                m_code.setExtraOperands(instruction, operands);
+            function.push_back(instruction);
+        }
+    }
+
+    code.erase(code.begin() + functionStart, code.end());
+    code.insert(code.end(), function.begin(), function.end());
+}
+
+void SSABuilder::printStats(std::ostream &os) const
+{
+    os << "[ssa] " << m_removedLoads << " loads and " << m_removedStores << " stores promoted, "
+       << m_insertedPhis << " phis inserted" << std::endl;
+}
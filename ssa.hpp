@@ -0,0 +1,103 @@
+#ifndef COMPI_HW5_SSA_H
+#define COMPI_HW5_SSA_H
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+#include "bp.hpp"
+
+using std::vector;
+using std::unordered_map;
+
+/**
+ * Promotes the stack slots of a function to SSA values, following "Simple and Efficient
+ * Construction of Static Single Assignment Form" (Braun et al.).
+ * Runs when the function is closed, so every branch is already backpatched: the blocks are
+ * filled in order, a block is sealed once all of its predecessors are filled (so a loop
+ * header keeps incomplete phis until its back edge is filled), every load is replaced with
+ * the reaching definition and the stores are dropped. Unreachable blocks are removed.
+ */
+class SSABuilder
+{
+public:
+    SSABuilder(CodeBuffer &codeBuffer) : m_code(codeBuffer), m_blocks(), m_blockOf(), m_defs(),
+                                         m_phis(), m_incomplete(), m_replace(),
+                                         m_removedLoads(0), m_removedStores(0), m_insertedPhis(0) {}
+
+    SSABuilder(SSABuilder const &) = delete;
+    void operator=(SSABuilder const &) = delete;
+
+    /* rewrite the function that starts at the FUNC_BEGIN at functionStart (the tail of the buffer)*/
+    void run(int functionStart);
+
+    void printStats(std::ostream &os) const;
+
+private:
+    struct Block
+    {
+        LabelId label;
+        /* the instructions of the block (without its label) are in [begin, end)*/
+        int begin;
+        int end;
+        vector<int> preds;
+        vector<int> succs;
+        bool reachable;
+        bool filled;
+        bool sealed;
+        /* the phis placed at the head of the block*/
+        vector<int> phis;
+    };
+
+    struct Phi
+    {
+        int block;
+        TypeId type;
+        Value dst;
+        vector<ExtraOperand> operands;
+        bool removed;
+    };
+
+    /* split the function to blocks and connect them*/
+    void buildBlocks(int functionStart);
+
+    void fillBlock(int block);
+
+    void sealBlock(int block);
+
+    /* the value of the slot at the end of the block*/
+    Value readVariable(long long slot, TypeId type, int block);
+
+    Value readVariableRecursive(long long slot, TypeId type, int block);
+
+    void writeVariable(long long slot, int block, Value value) { m_defs[block][slot] = value; }
+
+    /* create an operandless phi at the head of the block, return its index*/
+    int newPhi(int block, TypeId type);
+
+    Value addPhiOperands(long long slot, int phi);
+
+    /* replace a phi whose operands are all the same value (or itself) with that value*/
+    Value tryRemoveTrivialPhi(int phi);
+
+    /* follow the replacements of removed loads and phis*/
+    Value resolve(Value value);
+
+    /* write the promoted function back in place of the original one*/
+    void rewrite(int functionStart);
+
+    CodeBuffer &m_code;
+    vector<Block> m_blocks;
+    unordered_map<LabelId, int> m_blockOf;
+    /* block --> slot --> its current definition in the block*/
+    vector<unordered_map<long long, Value>> m_defs;
+    vector<Phi> m_phis;
+    /* block --> slot --> the phi that waits for the block to be sealed*/
+    vector<unordered_map<long long, int>> m_incomplete;
+    /* register of a removed load / phi --> the value that replaced it*/
+    unordered_map<long long, Value> m_replace;
+
+    size_t m_removedLoads;
+    size_t m_removedStores;
+    size_t m_insertedPhis;
+};
+
+#endif
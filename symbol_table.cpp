@@ -1,7 +1,8 @@
 #include "symbol_table_intf.h"
+#include "compiler.hpp"
 #include <assert.h>
 
-bool compareTypeVectors(const vector<string> &v1, const vector<string> &v2)
+bool compareTypeVectors(const vector<TypeId> &v1, const vector<TypeId> &v2)
 {
     /* sizes have to be the same*/
     if (v1.size() != v2.size())
@@ -17,37 +18,39 @@ bool compareTypeVectors(const vector<string> &v1, const vector<string> &v2)
     return true;
 }
 
+/* encode a types vector as a string key, one char per type*/
+static string typesSignature(const vector<TypeId> &types)
+{
+    string signature(types.size(), '\0');
+    for (size_t i = 0; i < types.size(); i++)
+    {
+        signature[i] = static_cast<char>(types[i]);
+    }
+    return signature;
+}
+
 /* CLASS Symbol*/
 
+void Symbol::printSymbol()
+{
+    output::printID(CompilerContext::current().nameInterner.str(m_name), m_offset, getPrintingType());
+}
+
 string Symbol::getPrintingType()
 {
     /* if this symbol isn't a function, no special printing is needed*/
-    if (m_type != "func")
+    if (m_type != TypeId::FUNC)
     {
-        return upperCase(m_type);
+        return output::typeToString(m_type);
     }
     /* if it's a func, upper case the parameters*/
     vector<string> upperParameters;
     for (auto it = m_parameters.begin(); it != m_parameters.end(); it++)
     {
-        upperParameters.push_back(upperCase(*it));
+        upperParameters.push_back(output::typeToString(*it));
     }
     /* Use the given function*/
-    return output::makeFunctionType(upperCase(m_returnType), upperParameters);
-}
-
-string Symbol::upperCase(const string str)
-{
-    if (str == "bool")
-        return "BOOL";
-    else if (str == "byte")
-        return "BYTE";
-    else if (str == "int")
-        return "INT";
-    else if (str == "void")
-        return "VOID";
-    else
-        return "STRING";
+    return output::makeFunctionType(output::typeToString(m_returnType), upperParameters);
 }
 
 /* CLASS Scope */
@@ -61,36 +64,6 @@ Scope::~Scope()
     m_symbols.clear();
 }
 
-bool Scope::isSymbolExist(const string name)
-{
-    for (auto &sym : m_symbols)
-    {
-        if (sym->m_name == name)
-            return true;
-    }
-    return false;
-}
-
-bool Scope::getSymbol(const string name, PSymbol *pSymbolOut)
-{
-    if (!isSymbolExist(name))
-    {
-        *pSymbolOut = nullptr;
-        return false;
-    }
-    /* otherwise assign the correct value (using a copy c'tor) and return true*/
-    for (auto &sym : m_symbols)
-    {
-        if (sym->m_name == name)
-        {
-            *pSymbolOut = sym;
-            return true;
-        }
-    }
-    /* not supposed to be here*/
-    assert(false);
-}
-
 void Scope::printScope()
 {
     for (auto &sym : m_symbols)
@@ -100,29 +73,15 @@ void Scope::printScope()
     }
 }
 
-bool Scope::getFuncSymbol(const string name, const vector<string> &parametersTypes,
-                          PSymbol *pSymbolOut)
-{
-    /* get the iterator of the symbol*/
-    getSymbol(name, pSymbolOut);
-    /* if it's not a function, return false*/
-    if ((*pSymbolOut)->m_type != "func")
-        return false;
-    /* if it's not the same params, return false*/
-    if ((*pSymbolOut)->m_parameters != parametersTypes)
-        return false;
-    return true;
-}
-
 /* CLASS SymbolTable */
 
-SymbolTable::SymbolTable() : m_scopes(), m_offsets(), m_distributer(0)
+SymbolTable::SymbolTable(NameInterner &names) : m_names(names), m_scopes(), m_bindings(), m_loopDepth(0), m_functions(), m_offsets(), m_distributer(0)
 {
     /* Add a new non-loop (hence the false) Scope*/
     pushScope(false);
     /* Add the basic two functions as symbols*/
-    insertFuncSymbol("print", "void", false, {"string"});
-    insertFuncSymbol("printi", "void", false, {"int"});
+    insertFuncSymbol(m_names.intern("print"), TypeId::VOID, false, {TypeId::STRING});
+    insertFuncSymbol(m_names.intern("printi"), TypeId::VOID, false, {TypeId::INT});
 }
 
 SymbolTable::~SymbolTable()
@@ -132,31 +91,52 @@ SymbolTable::~SymbolTable()
     {
         delete *it;
     }
+    m_bindings.clear();
 }
 
-void SymbolTable::pushScope(bool isLoop, string returnType)
+void SymbolTable::bind(NameId name, PSymbol pSymbol)
+{
+    if (name >= m_bindings.size())
+    {
+        m_bindings.resize(name + 1);
+    }
+    m_bindings[name].push_back(pSymbol);
+}
+
+vector<PSymbol> *SymbolTable::getBindings(NameId name)
+{
+    if (name >= m_bindings.size() || m_bindings[name].empty())
+    {
+        return nullptr;
+    }
+    return &m_bindings[name];
+}
+
+void SymbolTable::pushScope(bool isLoop, TypeId returnType)
 {
     /* Allocate a new empty Scope*/
     PScope scope = new Scope(isLoop, returnType);
-    string rbp;
     /* Handling for the first Scope inserted*/
     if (m_offsets.empty())
     {
         /* Start the first scope with 0 offset*/
         m_offsets.push(0);
-        /* Address is empty for the first rbp*/
-        rbp = "";
     }
     else
     {
         /* Duplicate the offset at the top of the offsets stack*/
         int offset = m_offsets.top();
         m_offsets.push(offset);
-        /* Address for the next rbp is the last one in the m_scopes vec*/
-        rbp = m_scopes.back()->m_rbp;
+        /* Inner scopes return from the function they are nested in*/
+        if (returnType == TypeId::NONE)
+        {
+            scope->m_closestReturnType = m_scopes.back()->m_closestReturnType;
+        }
+    }
+    if (isLoop)
+    {
+        m_loopDepth++;
     }
-    /* Update to correct rbp*/
-    scope->m_rbp = rbp;
     /* push the scope to the stack*/
     m_scopes.push_back(scope);
 }
@@ -172,6 +152,21 @@ void SymbolTable::popScope()
     PScope pScope = m_scopes.back();
     /* Pop the scope from the vector*/
     m_scopes.pop_back();
+    /* Unwind only the bindings this scope added, newest first*/
+    for (auto it = pScope->m_symbols.rbegin(); it != pScope->m_symbols.rend(); it++)
+    {
+        vector<PSymbol> &binding = m_bindings[(*it)->m_name];
+        assert(binding.back() == *it);
+        binding.pop_back();
+        if ((*it)->m_type == TypeId::FUNC)
+        {
+            m_functions.erase((*it)->m_name);
+        }
+    }
+    if (pScope->isLoop())
+    {
+        m_loopDepth--;
+    }
     if (should_print)
     {
         /* Print end scope*/
@@ -185,7 +180,7 @@ void SymbolTable::popScope()
     delete pScope;
 }
 
-int SymbolTable::insertSymbol(const string name, string type)
+int SymbolTable::insertSymbol(NameId name, TypeId type)
 {
     /* assert that there is a Scope with an offset already*/
     assert(m_offsets.size() > 0 && m_scopes.size() > 0);
@@ -193,8 +188,9 @@ int SymbolTable::insertSymbol(const string name, string type)
     int offset = m_offsets.top();
     /* Create the new symbol*/
     PSymbol pSymbol = new Symbol(name, type, offset);
-    /* Add it to the current scope*/
+    /* Add it to the current scope and to the index*/
     m_scopes.back()->insertSymbol(pSymbol);
+    bind(name, pSymbol);
     /* Update offset head stack to +1*/
     m_offsets.pop();
     m_offsets.push(offset + 1);
@@ -202,240 +198,196 @@ int SymbolTable::insertSymbol(const string name, string type)
     return offset;
 }
 
-int SymbolTable::insertFuncSymbol(const string name, string returnType, bool isOverride,
-                                   const vector<string> &parametersTypes)
+int SymbolTable::insertFuncSymbol(NameId name, TypeId returnType, bool isOverride,
+                                   const vector<TypeId> &parametersTypes)
 {
     assert(m_offsets.size() > 0 && m_scopes.size() > 0);
     /* Get current offset*/
     int offset = m_offsets.top();
     /* Create the new function symbol*/
     int version = m_distributer;
-    PSymbol pFuncSymbol = new Symbol(name, "func", 0, isOverride, version, returnType, parametersTypes);
+    PSymbol pFuncSymbol = new Symbol(name, TypeId::FUNC, 0, isOverride, version, returnType, parametersTypes);
     /* Update the distributer*/
     m_distributer++;
-    /* Add it to the current scope*/
+    /* Add it to the current scope and to the index*/
     m_scopes.back()->insertSymbol(pFuncSymbol);
+    bind(name, pFuncSymbol);
+    /* Index the new overload by its arity, previous resolutions of this name are stale now*/
+    FuncOverloads &overloads = m_functions[name];
+    overloads.m_byArity[parametersTypes.size()].push_back(pFuncSymbol);
+    overloads.m_callCache.clear();
     /* return the version of the function inserted*/
     return version;
 }
 
-bool SymbolTable::isSymbolExist(const string name)
+bool SymbolTable::isSymbolExist(NameId name)
 {
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
-    {
-        /* (*it) is the current scope*/
-        if ((*it)->isSymbolExist(name))
-        {
-            return true;
-        }
-    }
-    return false;
+    return getBindings(name) != nullptr;
 }
 
-int SymbolTable::getSymbolOffset(const string name)
+int SymbolTable::getSymbolOffset(NameId name)
 {
-    PSymbol pSymbol;
-    /* Search all scopes one at a time from the begining for the symbol*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
-    {
-        /* (*it) is the current scope*/
-        if ((*it)->getSymbol(name, &pSymbol) == true)
-        {
-            /* we found the symbol*/
-            return pSymbol->m_offset;
-        }
-    }
-    /* not supposed to get here*/
-    assert(false);
+    vector<PSymbol> *bindings = getBindings(name);
+    /* not supposed to get here without the symbol*/
+    assert(bindings != nullptr);
+    return bindings->front()->m_offset;
 }
 
-int SymbolTable::getFuncSymbolVersion(const string name)
+int SymbolTable::getFuncSymbolVersion(NameId name)
 {
-    PSymbol pSymbol;
-    /* Search all scopes one at a time from the begining for the symbol*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
+    vector<PSymbol> *bindings = getBindings(name);
+    /* the symbol doesn't exist*/
+    if (bindings == nullptr)
     {
-        /* (*it) is the current scope*/
-        if ((*it)->getSymbol(name, &pSymbol) == true)
-        {
-            /* we found the symbol*/
-            return pSymbol->m_version;
-        }
+        return -1;
     }
-    /* the symbol doesn't exist*/
-    return -1;
+    return bindings->front()->m_version;
 }
 
-bool SymbolTable::isFuncSymbolNameExist(const string name)
+bool SymbolTable::isFuncSymbolNameExist(NameId name)
 {
-    return getSymbolType(name) == "func";
+    return getSymbolType(name) == TypeId::FUNC;
 }
 
-vector<string> SymbolTable::getFuncDeclReturnTypes(const string name, const vector<string> &parametersTypes)
+vector<TypeId> SymbolTable::getFuncDeclReturnTypes(NameId name, const vector<TypeId> &parametersTypes)
 {
-    PScope pScope;
-    PSymbol pSymbol;
-    vector<string> returnTypes;
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
+    vector<TypeId> returnTypes;
+    auto overloads = m_functions.find(name);
+    if (overloads == m_functions.end())
+    {
+        return returnTypes;
+    }
+    auto sameArity = overloads->second.m_byArity.find(parametersTypes.size());
+    if (sameArity == overloads->second.m_byArity.end())
+    {
+        return returnTypes;
+    }
+    /* Go over all of the overloads with the same number of parameters*/
+    for (auto &pSymbol : sameArity->second)
     {
-        pScope = *it;
-        /* Go over all of the symbols in the scope*/
-        for (auto symIt = pScope->m_symbols.begin(); symIt != pScope->m_symbols.end(); symIt++)
+        /* if the symbol has the same parameters types EXACTLY*/
+        if (pSymbol->m_parameters == parametersTypes)
         {
-            pSymbol = *symIt;
-            /* if the symbol has the same name && if the symbol has the same parameters types EXACTLY*/
-            if (pSymbol->m_name == name && pSymbol->m_parameters == parametersTypes)
-            {
-                returnTypes.push_back(pSymbol->m_returnType);
-            }
+            returnTypes.push_back(pSymbol->m_returnType);
         }
     }
     return returnTypes;
 }
 
-vector<pair<string, int>> SymbolTable::getLegalCallReturnTypes(const string name, const vector<string> &parametersTypes)
+vector<pair<TypeId, int>> SymbolTable::getLegalCallReturnTypes(NameId name, const vector<TypeId> &parametersTypes)
 {
-    PScope pScope;
-    PSymbol pSymbol;
-    vector<pair<string, int>> returnTypes;
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
+    vector<pair<TypeId, int>> returnTypes;
+    for (auto &pSymbol : resolveCall(name, parametersTypes))
     {
-        pScope = *it;
-        /* Go over all of the symbols in the scope*/
-        for (auto symIt = pScope->m_symbols.begin(); symIt != pScope->m_symbols.end(); symIt++)
-        {
-            pSymbol = *symIt;
-            /* if the symbol has the same name && if the symbol has the "same" parameters types*/
-            if (pSymbol->m_name == name && compareTypeVectors(pSymbol->m_parameters, parametersTypes))
-            {
-                auto pair = std::pair<string, int>(pSymbol->m_returnType, pSymbol->m_version);
-                returnTypes.push_back(pair);
-            }
-        }
+        auto pair = std::pair<TypeId, int>(pSymbol->m_returnType, pSymbol->m_version);
+        returnTypes.push_back(pair);
     }
     return returnTypes;
 }
 
-vector<string> SymbolTable::getFuncParameters(const string name, const int version)
+const vector<PSymbol> &SymbolTable::resolveCall(NameId name, const vector<TypeId> &parametersTypes)
 {
-    PScope pScope;
-    PSymbol pSymbol;
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
+    static const vector<PSymbol> noOverloads;
+    auto overloads = m_functions.find(name);
+    if (overloads == m_functions.end())
+    {
+        return noOverloads;
+    }
+    /* a call with the same argument types was already resolved*/
+    string signature = typesSignature(parametersTypes);
+    auto cached = overloads->second.m_callCache.find(signature);
+    if (cached != overloads->second.m_callCache.end())
+    {
+        return cached->second;
+    }
+    vector<PSymbol> &result = overloads->second.m_callCache[signature];
+    auto sameArity = overloads->second.m_byArity.find(parametersTypes.size());
+    if (sameArity != overloads->second.m_byArity.end())
     {
-        pScope = *it;
-        /* Go over all of the symbols in the scope*/
-        for (auto symIt = pScope->m_symbols.begin(); symIt != pScope->m_symbols.end(); symIt++)
+        /* only overloads with the same number of parameters can match*/
+        for (auto &pSymbol : sameArity->second)
         {
-            pSymbol = *symIt;
-            /* if the symbol has the same name && if the symbol has the same version*/
-            if (pSymbol->m_name == name && pSymbol->m_version == version)
+            /* if the symbol has the "same" parameters types*/
+            if (compareTypeVectors(pSymbol->m_parameters, parametersTypes))
             {
-                return pSymbol->m_parameters;
+                result.push_back(pSymbol);
             }
         }
     }
-    return {};
+    return result;
 }
 
-bool SymbolTable::isFuncSymbolExist(const string name, const vector<string> &parametersTypes)
+vector<TypeId> SymbolTable::getFuncParameters(NameId name, const int version)
 {
-    PSymbol pSymbol;
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
+    vector<PSymbol> *bindings = getBindings(name);
+    if (bindings == nullptr)
     {
-        /* (*it) is the current scope. Try to get the function symbol from the scope.*/
-        if ((*it)->getFuncSymbol(name, parametersTypes, &pSymbol))
-        {
-            return true;
-        }
+        return {};
     }
-    return false;
-}
-
-string SymbolTable::getSymbolType(const string name)
-{
-    PSymbol pSymbol;
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
+    /* Go over all of the symbols with this name*/
+    for (auto &pSymbol : *bindings)
     {
-        /* (*it) is the current scope. Try to get the symbol from the scope.*/
-        if ((*it)->getSymbol(name, &pSymbol))
+        /* if the symbol has the same version*/
+        if (pSymbol->m_version == version)
         {
-            /* otherwise, we found it*/
-            return pSymbol->m_type;
+            return pSymbol->m_parameters;
         }
     }
-    return "";
+    return {};
 }
 
-string SymbolTable::getClosestReturnType()
+bool SymbolTable::isFuncSymbolExist(NameId name, const vector<TypeId> &parametersTypes)
 {
-    /* go over the vectors from last to first using reverse iterator*/
-    for (auto it = m_scopes.rbegin(); it != m_scopes.rend(); it++)
+    vector<PSymbol> *bindings = getBindings(name);
+    if (bindings == nullptr)
     {
-        /* (*it) is the current scope */
-        string scopeReturn = (*it)->getReturnType();
-        /* if the scopeReturn is defined, return it*/
-        if (scopeReturn != "")
+        return false;
+    }
+    for (auto &pSymbol : *bindings)
+    {
+        if (pSymbol->m_type == TypeId::FUNC && pSymbol->m_parameters == parametersTypes)
         {
-            return scopeReturn;
+            return true;
         }
     }
-    return "";
+    return false;
 }
 
-string SymbolTable::getCurrentRbp()
+TypeId SymbolTable::getSymbolType(NameId name)
 {
-    PScope currentScope = m_scopes.back();
-    /* the m_scopes is not suppose to be empty. if so, it's a bug*/
-    assert(currentScope != nullptr);
-    return currentScope->m_rbp;
+    vector<PSymbol> *bindings = getBindings(name);
+    if (bindings == nullptr)
+    {
+        return TypeId::NONE;
+    }
+    return bindings->front()->m_type;
 }
 
-void SymbolTable::setCurrentRbp(string newRbp)
+TypeId SymbolTable::getClosestReturnType()
 {
-    PScope currentScope = m_scopes.back();
     /* the m_scopes is not suppose to be empty. if so, it's a bug*/
-    assert(currentScope != nullptr);
-    /* update the rbp*/
-    currentScope->m_rbp = newRbp; 
+    assert(!m_scopes.empty());
+    return m_scopes.back()->m_closestReturnType;
 }
 
-bool SymbolTable::isSymbolOverride(const string name)
+bool SymbolTable::isSymbolOverride(NameId name)
 {
-    PSymbol pSymbolToCheck;
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
+    vector<PSymbol> *bindings = getBindings(name);
+    if (bindings == nullptr)
     {
-        /* (*it) is the current scope. Try to get the symbol from the scope.*/
-        if ((*it)->getSymbol(name, &pSymbolToCheck))
-        {
-            /* we found it. return if override AND a function symbol*/
-            return pSymbolToCheck->m_isOverride && pSymbolToCheck->m_type == "func";
-        }
+        return false;
     }
-    return false;
+    PSymbol pSymbolToCheck = bindings->front();
+    /* return if override AND a function symbol*/
+    return pSymbolToCheck->m_isOverride && pSymbolToCheck->m_type == TypeId::FUNC;
 }
 
 bool SymbolTable::isWithinLoop()
 {
-    /* Search all scopes one at a time from the begining*/
-    for (auto it = m_scopes.begin(); it != m_scopes.end(); it++)
-    {
-        /* (*it) is the current scope*/
-        if ((*it)->isLoop())
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_loopDepth > 0;
 }
 
-string SymbolTable::insertArgs(vector<string> types, vector<string> names)
+NameId SymbolTable::insertArgs(const vector<TypeId> &types, const vector<NameId> &names)
 {
     int offset = -1;
     assert(types.size() == names.size());
@@ -448,40 +400,24 @@ string SymbolTable::insertArgs(vector<string> types, vector<string> names)
         }
         /* Create the new function symbol*/
         PSymbol pSymbol = new Symbol(names[i], types[i], offset);
-        /* Add it to the current scope*/
+        /* Add it to the current scope and to the index*/
         m_scopes.back()->insertSymbol(pSymbol);
+        bind(names[i], pSymbol);
         offset--;
     }
-    return "";
-}
-
-bool SymbolTable::checkTypes(string leftType, string rightType)
-{
-    /* if the types are the same, everything is fine*/
-    if (leftType == rightType)
-    {
-        return true;
-    }
-    /* check for the (int <-- byte) scenario*/
-    if (leftType == "int" && rightType == "byte")
-    {
-        return true;
-    }
-    /* assignment is wrong*/
-    return false;
+    return NO_NAME;
 }
 
 void SymbolTable::checkMain()
 {
-    vector<string> returnTypesFromMain = this->getFuncDeclReturnTypes("main", {});
+    vector<TypeId> returnTypesFromMain = this->getFuncDeclReturnTypes(m_names.intern("main"), {});
 
-    if (returnTypesFromMain.size() == 1 && returnTypesFromMain[0] == "void")
+    if (returnTypesFromMain.size() == 1 && returnTypesFromMain[0] == TypeId::VOID)
     {
         this->popScope();
     }
     else
     {
         output::errorMainMissing();
-        exit(1);
     }
 }
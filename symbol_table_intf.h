@@ -4,10 +4,14 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <stack>
 #include "hw3_output.hpp"
+#include "types.hpp"
+#include "interner.hpp"
 /* Using sttmnts for easy reding this document*/
 using std::map;
+using std::unordered_map;
 using std::stack;
 using std::string;
 using std::vector;
@@ -19,8 +23,8 @@ public:
     /**
      * c'tor that simply assigns the parameters in the equivelant members
      */
-    Symbol(const string name, const string type, int offset = 0, bool isOverride = false, int version = -1,
-           const string returnType = "", const vector<string> &parameters = {""}) : m_name(name),
+    Symbol(NameId name, const TypeId type, int offset = 0, bool isOverride = false, int version = -1,
+           const TypeId returnType = TypeId::NONE, const vector<TypeId> &parameters = {}) : m_name(name),
                                                                                     m_type(type),
                                                                                     m_offset(offset),
                                                                                     m_isOverride(isOverride),
@@ -39,7 +43,7 @@ public:
      * printing, if needed.
      * We use output::printID for this one.
      */
-    void printSymbol() { output::printID(m_name, m_offset, getPrintingType()); };
+    void printSymbol();
 
     /**
      * get the "type" to print for this symbol.
@@ -48,22 +52,15 @@ public:
      */
     string getPrintingType();
 
-    /**
-     * get the str upper cased. Used for printing.
-     * @param str the string to upper case
-     * @return the string upper cased
-     */
-    string upperCase(const string str);
-
     /*******************MEMBERS**************************/
     /* Public members since this class is used only by the SymbolTable class*/
 
-    /* The name of the symbol as defined in the code */
-    string m_name;
+    /* The (interned) name of the symbol as defined in the code */
+    NameId m_name;
     /* The type of the symbol: [num, char,]*/
-    string m_type;
+    TypeId m_type;
     /* Return value type*/
-    string m_returnType;
+    TypeId m_returnType;
     /* Boolean stating if the function is declared with 'override'*/
     bool m_isOverride;
     /* The offset of this symbol in the current scope stack*/
@@ -71,7 +68,7 @@ public:
     /* The serial number of the function. If it is -1 -> then this is not a function*/
     int m_version;
     /* Parameters of the function */
-    vector<string> m_parameters;
+    vector<TypeId> m_parameters;
 };
 using PSymbol = Symbol *;
 
@@ -80,14 +77,14 @@ class Scope
 {
 public:
     /*default c'tor and d'tor since the values aren't known yet*/
-    Scope(bool isLoop, string returnType = "") : m_symbols(),
+    Scope(bool isLoop, TypeId returnType = TypeId::NONE) : m_symbols(),
                                                  m_isLoop(isLoop),
                                                  m_returnType(returnType),
-                                                 m_rbp{""}{};
+                                                 m_closestReturnType(returnType){};
 
     ~Scope();
 
-    string getReturnType() { return m_returnType; };
+    TypeId getReturnType() { return m_returnType; };
 
     /**
      * Insert a symbol to the Scope. No checks are preformed so assumes it is supposed to be inserted.
@@ -95,35 +92,6 @@ public:
      */
     void insertSymbol(PSymbol pSymbol) { m_symbols.push_back(pSymbol); };
 
-    /**
-     * Return a boolean stating if exists a symbol with the given name in the Scope
-     * @param name the symbol to look for in the scope
-     * @return True - if the symbol exsits. False otherwise.
-     */
-    bool isSymbolExist(const string name);
-
-    /**
-     * Get the symbol from the scope if it exists
-     * @param name the name of the symbol to get from the scope
-     * @param pSymbolOut out parameter for the symbol
-     * @return True - the symbol was found and it is inside pSymbolOut
-     *         False - the symbol is not in the table
-     *         The out parameter is nullptr in case of false
-     */
-    bool getSymbol(const string name, PSymbol *pSymbolOut);
-
-    /**
-     * Get the function symbol from the scope if it exists
-     * @param name the name of the function symbol to get from the scope
-     * @param parametersTypes the params of the requested function
-     * @param pSymbolOut out parameter for the function symbol
-     * @return True - the symbol was found and it is inside pSymbolOut
-     *         False - the symbol is not in the table
-     *         The out parameter is nullptr in case of false
-     */
-    bool getFuncSymbol(const string name, const vector<string> &parametersTypes,
-                       PSymbol *pSymbolOut);
-
     /* returns if the isLoop member is True / False*/
     bool isLoop() { return m_isLoop; }
 
@@ -136,28 +104,27 @@ public:
     /*******************MEMBERS**************************/
     /* Public members since this class is used only by the SymbolTable class*/
 
-    /* The symbols of this scope is a HT of the symbols in the scope.
-     * key == name of the symbol
-     * PSymbol == ptr to the symbol located in the cell*/
+    /* The symbols of this scope in the order they were declared. The scope owns them,
+     * the SymbolTable index only points at them until the scope is popped*/
     vector<PSymbol> m_symbols;
     /* boolean stating if this scope is a loop*/
     bool m_isLoop;
     /* the return type of the scope - gets a value only if this is a function scope*/
-    string m_returnType;
-    /* the name of the register holding the rbp of this scope*/
-    string m_rbp;
+    TypeId m_returnType;
+    /* the return type of the function this scope is nested in (inherited on push)*/
+    TypeId m_closestReturnType;
 };
 using PScope = Scope *;
 
 class SymbolTable
 {
 public:
-    /*c'tor and d'tor aren't default*/
-    SymbolTable();
+    /*c'tor and d'tor aren't default. The names of the library functions and main are interned in names*/
+    SymbolTable(NameInterner &names);
     ~SymbolTable();
 
     /* push a new empty scope to the scope vector*/
-    void pushScope(bool isLoop, string returnType = "");
+    void pushScope(bool isLoop, TypeId returnType = TypeId::NONE);
 
     /* pop the latest scope from the scope vector*/
     void popScope();
@@ -169,7 +136,7 @@ public:
      * @param type the type of the symbol to add
      * @return int - the offset of the symbol inserted
      */
-    int insertSymbol(const string name, string type);
+    int insertSymbol(NameId name, TypeId type);
 
     /**
      * Create a function symbol from the given parameters and insert to the latest scope.
@@ -181,7 +148,7 @@ public:
      * 
      * @return int - the version number of the function inserted
      */
-    int insertFuncSymbol(const string name, string returnType, bool isOverride, const vector<string> &parametersTypes);
+    int insertFuncSymbol(NameId name, TypeId returnType, bool isOverride, const vector<TypeId> &parametersTypes);
 
     /**
      * Return a boolean stating if exists a symbol within any of the Scopes
@@ -189,14 +156,14 @@ public:
      * @return True - the symbol exist
      *         False - the symbol doesn't exist
      */
-    bool isSymbolExist(const string name);
+    bool isSymbolExist(NameId name);
 
     /**
      * returns the offset of the symbol. HAVE to make sure it exsits beforehand.
      * @param name the name of the symbol 
      * @return int - the offset of the symbol
     */
-    int getSymbolOffset(const string name);
+    int getSymbolOffset(NameId name);
 
     /**
      * Get the function Symbol m_version member
@@ -204,7 +171,7 @@ public:
      * @param name the name of the function to retrieve
      * @return int - the m_version member of the function
      */
-    int getFuncSymbolVersion(const string name);
+    int getFuncSymbolVersion(NameId name);
 
     /**
      * Return a boolean stating if exists a *function* symbol within any of the Scopes
@@ -212,37 +179,47 @@ public:
      * @return True - the symbol exist
      *         False - the symbol doesn't exist
      */
-    bool isFuncSymbolNameExist(const string name);
+    bool isFuncSymbolNameExist(NameId name);
 
     /**
      * Checks if a function named "name" exists. Then it makes sure that the given parameters types are the same (in order also)
      * as the parameters' types in the symbol we found.
      * @param name the name of the function from the call
-     * @param parametersTypes vector<string> of the parameters that were stated in the call
+     * @param parametersTypes vector<TypeId> of the parameters that were stated in the call
      */
-    bool isFuncSymbolExist(const string name, const vector<string> &parametersTypes);
+    bool isFuncSymbolExist(NameId name, const vector<TypeId> &parametersTypes);
 
     /**
-     * Go over all of the scopes:
+     * Go over all of the overloads of "name":
      * Look for any function named "name" that there is an EXACT type match of the
      * given parametersTypes to its arguments.
      * @param name name of the function
      * @param parametersTypes the types of the declaration
-     * @return vector<string> all of the return types of the suitable functions
+     * @return vector<TypeId> all of the return types of the suitable functions
      *         empty vector if no func allowed
      */
-    vector<string> getFuncDeclReturnTypes(const string name, const vector<string> &parametersTypes);
+    vector<TypeId> getFuncDeclReturnTypes(NameId name, const vector<TypeId> &parametersTypes);
 
     /**
-     * Go over all of the scopes:
+     * Go over all of the overloads of "name":
      * Look for any function named "name" that there is a possible assignment of the
      * given parametersTypes to its arguments.
      * @param name name of the function in the call
      * @param parametersTypes types in the call
-     * @return vector<pair<string, int>> all of the (return type, version) pairs of the suitable functions
+     * @return vector<pair<TypeId, int>> all of the (return type, version) pairs of the suitable functions
      *         empty vector if no func allowed
      */
-    vector<pair<string, int>> getLegalCallReturnTypes(const string name, const vector<string> &parametersTypes);
+    vector<pair<TypeId, int>> getLegalCallReturnTypes(NameId name, const vector<TypeId> &parametersTypes);
+
+    /**
+     * Resolve a call through the overload index: only the overloads of "name" with the
+     * same arity are checked, and the result is memoized per argument types signature
+     * until another overload of "name" is inserted.
+     * @param name name of the function in the call
+     * @param parametersTypes types in the call
+     * @return all of the overloads the call can be assigned to, empty if there isn't any
+     */
+    const vector<PSymbol> &resolveCall(NameId name, const vector<TypeId> &parametersTypes);
 
     /**
      * Get the m_parameters member of a function symbol with the given name AND version.
@@ -250,37 +227,22 @@ public:
      * @param name the name of the function to look for
      * @param version the version of the name since it might have been overriden
     */
-    vector<string> getFuncParameters(const string name, const int version);
+    vector<TypeId> getFuncParameters(NameId name, const int version);
 
     /**
      * Get the symbol's type from any of the Scopes (if it exists).
-     * If it does not exist "" is returned.
+     * If it does not exist TypeId::NONE is returned.
      * @param name the name of the symbol to get from the scope
-     * @return string the type of the symbol
-     *         string "" if doesn't exist in any scope
-     */
-    string getSymbolType(const string name);
-
-    /**
-     * Go over the scopes from last to first and find the closest
-     * return type.
-     * @return string indicating the return type
+     * @return TypeId the type of the symbol
+     *         TypeId::NONE if doesn't exist in any scope
      */
-    string getClosestReturnType();
-
-    /**
-     * Get the rbp of the current Scope.
-     * @return string - the rbp address in a string value
-     * @note make sure to call this function when there is at least one scope
-    */
-    string getCurrentRbp();
+    TypeId getSymbolType(NameId name);
 
     /**
-     * Set the rbp of the current scope (the last one)
-     * 
-     * @param newRbp - reg holding the address of the rbp
+     * Get the return type of the function the current scope is nested in.
+     * @return TypeId indicating the return type
      */
-    void setCurrentRbp(string newRbp);
+    TypeId getClosestReturnType();
 
     /**
      * Checks if there exists a symbol named "name" in the table, and if it also
@@ -289,25 +251,55 @@ public:
      * @return True - the symbol exists in one of the scopes && it is a funcSymbol && isOverride == True
      *         False - one of the above doesn't hold
      */
-    bool isSymbolOverride(const string name);
+    bool isSymbolOverride(NameId name);
 
     /**
      * Checks if one of the current scopes is within a loop.
-     * Iterating over all of the m_scopes member.
      * @return True - one of the scopes is a loop scope
      *         False - there is not any loop scope "open"
      */
     bool isWithinLoop();
 
-    string insertArgs(vector<string> types, vector<string> names);
+    /**
+     * Insert the arguments of the function to the current scope (with negative offsets).
+     * @return the name of the first argument that is already defined, NO_NAME if there isn't any
+     */
+    NameId insertArgs(const vector<TypeId> &types, const vector<NameId> &names);
 
-    static bool checkTypes(string leftType, string rightType);
+    static bool checkTypes(TypeId leftType, TypeId rightType) { return isAssignable(leftType, rightType); }
 
     void checkMain();
 
 private:
+    /* push the symbol on the binding stack of its name*/
+    void bind(NameId name, PSymbol pSymbol);
+
+    /**
+     * Get the binding stack of the given name.
+     * @return the symbols named "name" from the outermost scope to the innermost one,
+     *         nullptr if there isn't any
+     */
+    vector<PSymbol> *getBindings(NameId name);
+
+    NameInterner &m_names;
     /* Vector of all of the scopes so far*/
     vector<PScope> m_scopes;
+    /* NameId --> stack of the visible symbols with this name (the back is the innermost).
+     * Function overloads are all kept in the same stack*/
+    vector<vector<PSymbol>> m_bindings;
+    /* number of loop scopes currently open*/
+    int m_loopDepth;
+
+    /* All of the overloads of a single function name*/
+    struct FuncOverloads
+    {
+        /* number of parameters --> the overloads with that arity, in declaration order*/
+        unordered_map<size_t, vector<PSymbol>> m_byArity;
+        /* signature of the call's argument types --> the overloads the call resolves to*/
+        unordered_map<string, vector<PSymbol>> m_callCache;
+    };
+    /* function name --> its overloads. Cleared when the global scope is popped*/
+    unordered_map<NameId, FuncOverloads> m_functions;
     /* Stack for the offsets as was shown in the tutorial*/
     stack<int> m_offsets;
     /* Serial number distributer*/
@@ -0,0 +1,369 @@
+/**
+ * Runs the tests of the given directories in parallel, like run.sh does one at a time:
+ * hw5 < name.in > name.lli, then lli < name.lli > name.res (or name.lli is copied to name.res
+ * when it is a compilation error), and name.res has to be the same as name.out (or name.in.out).
+ * The compile and execution time and peak memory of every test are recorded, a step that
+ * runs longer than the timeout is killed and the test fails. A directory that doesn't exist, or
+ * no tests at all, is an error rather than a pass.
+ * usage: test_runner [-j jobs] [--timeout seconds] [--hw5 path] [--lli path] [--json report.json]
+ *                    [--csv report.csv] [--] dir...
+ * The arguments between -- and the next -- are passed to hw5: test_runner -- --ssa -- our_tests
+ */
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+struct Step
+{
+    double seconds;
+    /* peak resident set size in KB*/
+    long peakKB;
+    bool timedOut;
+    /* the exit code, or 128 + the signal that killed it*/
+    int status;
+};
+
+struct Test
+{
+    string dir;
+    string name;
+    Step compile;
+    /* empty (ran is false) when hw5 printed a compilation error*/
+    Step run;
+    bool ran;
+    bool passed;
+};
+
+/**
+ * Run argv with stdin and stdout redirected to the given files, killing it after timeout seconds.
+ * The timer is set in the child and survives the exec, so no one has to watch the process.
+ */
+static Step runProcess(const vector<string> &argv, const string &in, const string &out, double timeout)
+{
+    Step step = {0, 0, false, 0};
+    /* built before the fork, the child of a threaded process shouldn't allocate*/
+    vector<char *> args;
+    for (const string &arg : argv)
+    {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        int inFd = open(in.c_str(), O_RDONLY);
+        int outFd = open(out.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int nullFd = open("/dev/null", O_WRONLY);
+        if (inFd < 0 || outFd < 0 || nullFd < 0)
+        {
+            _exit(127);
+        }
+        dup2(inFd, STDIN_FILENO);
+        dup2(outFd, STDOUT_FILENO);
+        dup2(nullFd, STDERR_FILENO);
+        struct itimerval timer = {};
+        timer.it_value.tv_sec = static_cast<long>(timeout);
+        timer.it_value.tv_usec = static_cast<long>((timeout - timer.it_value.tv_sec) * 1e6);
+        setitimer(ITIMER_REAL, &timer, nullptr);
+        execvp(args[0], args.data());
+        _exit(127);
+    }
+    int status = 0;
+    struct rusage usage = {};
+    wait4(pid, &status, 0, &usage);
+    step.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    step.peakKB = usage.ru_maxrss;
+    if (WIFSIGNALED(status))
+    {
+        step.timedOut = (WTERMSIG(status) == SIGALRM);
+        step.status = 128 + WTERMSIG(status);
+    }
+    else
+    {
+        step.status = WEXITSTATUS(status);
+    }
+    return step;
+}
+
+static bool readFile(const string &path, string &content)
+{
+    ifstream file(path, ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    ostringstream text;
+    text << file.rdbuf();
+    content = text.str();
+    return true;
+}
+
+/* the .in files of dir, sorted by name (without the extension). false if dir can't be read*/
+static bool listTests(const string &dir, vector<string> &names)
+{
+    DIR *handle = opendir(dir.c_str());
+    if (handle == nullptr)
+    {
+        return false;
+    }
+    for (struct dirent *entry = readdir(handle); entry != nullptr; entry = readdir(handle))
+    {
+        string file = entry->d_name;
+        if (file.size() > 3 && file.compare(file.size() - 3, 3, ".in") == 0)
+        {
+            names.push_back(file.substr(0, file.size() - 3));
+        }
+    }
+    closedir(handle);
+    sort(names.begin(), names.end());
+    return true;
+}
+
+static void runTest(Test &test, const string &hw5, const vector<string> &hw5Args, const string &lli, double timeout)
+{
+    string base = test.dir + "/" + test.name;
+    vector<string> compile = {hw5};
+    compile.insert(compile.end(), hw5Args.begin(), hw5Args.end());
+    test.compile = runProcess(compile, base + ".in", base + ".lli", timeout);
+    test.run = {0, 0, false, 0};
+    test.ran = false;
+    test.passed = false;
+    if (test.compile.timedOut)
+    {
+        return;
+    }
+
+    string code;
+    readFile(base + ".lli", code);
+    if (code.compare(0, 4, "line") == 0 || code.compare(0, 7, "Program") == 0)
+    {
+        /* a compilation error is the expected output as is*/
+        ofstream(base + ".res", ios::binary) << code;
+    }
+    else
+    {
+        test.run = runProcess({lli}, base + ".lli", base + ".res", timeout);
+        test.ran = true;
+        if (test.run.timedOut)
+        {
+            return;
+        }
+    }
+    /* name.out, or name.in.out as in hw5_win23_tests_v2*/
+    string result, expected;
+    bool hasExpected = readFile(base + ".out", expected) || readFile(base + ".in.out", expected);
+    test.passed = hasExpected && readFile(base + ".res", result) && result == expected;
+}
+
+static const char *statusOf(const Test &test)
+{
+    if (test.compile.timedOut || test.run.timedOut)
+        return "timeout";
+    return test.passed ? "pass" : "fail";
+}
+
+static string jsonString(const string &text)
+{
+    string quoted = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+static void writeJson(ostream &os, const vector<Test> &tests, unsigned jobs, double wall)
+{
+    size_t passed = 0, timeouts = 0;
+    os << "{\n  \"tests\": [\n";
+    for (size_t i = 0; i < tests.size(); i++)
+    {
+        const Test &test = tests[i];
+        passed += test.passed;
+        timeouts += (test.compile.timedOut || test.run.timedOut);
+        os << "    {\"dir\": " << jsonString(test.dir) << ", \"name\": " << jsonString(test.name)
+           << ", \"status\": \"" << statusOf(test) << "\""
+           << ", \"compile_ms\": " << test.compile.seconds * 1000 << ", \"compile_peak_kb\": " << test.compile.peakKB
+           << ", \"compile_exit\": " << test.compile.status
+           << ", \"run_ms\": " << test.run.seconds * 1000 << ", \"run_peak_kb\": " << test.run.peakKB
+           << ", \"ran\": " << (test.ran ? "true" : "false") << "}" << (i + 1 < tests.size() ? "," : "") << "\n";
+    }
+    os << "  ],\n  \"summary\": {\"total\": " << tests.size() << ", \"passed\": " << passed
+       << ", \"failed\": " << tests.size() - passed << ", \"timeouts\": " << timeouts
+       << ", \"jobs\": " << jobs << ", \"wall_ms\": " << wall * 1000 << "}\n}\n";
+}
+
+static void writeCsv(ostream &os, const vector<Test> &tests)
+{
+    os << "dir,name,status,compile_ms,compile_peak_kb,compile_exit,run_ms,run_peak_kb,ran\n";
+    for (const Test &test : tests)
+    {
+        os << test.dir << "," << test.name << "," << statusOf(test) << "," << test.compile.seconds * 1000 << ","
+           << test.compile.peakKB << "," << test.compile.status << "," << test.run.seconds * 1000 << ","
+           << test.run.peakKB << "," << (test.ran ? 1 : 0) << "\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned jobs = thread::hardware_concurrency();
+    double timeout = 10;
+    string hw5 = "./hw5";
+    string lli = "lli";
+    string jsonPath, csvPath;
+    vector<string> hw5Args;
+    vector<string> dirs;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc)
+        {
+            char *end;
+            long value = strtol(argv[++i], &end, 10);
+            if (end == argv[i] || *end != '\0' || value < 1)
+            {
+                cerr << "-j needs a positive number of jobs, not " << argv[i] << endl;
+                return 1;
+            }
+            jobs = static_cast<unsigned>(value);
+        }
+        else if (arg == "--timeout" && i + 1 < argc)
+        {
+            char *end;
+            errno = 0;
+            timeout = strtod(argv[++i], &end);
+            /* it becomes the seconds of an itimerval*/
+            if (end == argv[i] || *end != '\0' || errno == ERANGE || !(timeout > 0 && timeout < 1e9))
+            {
+                cerr << "--timeout needs a positive number of seconds, not " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--hw5" && i + 1 < argc)
+            hw5 = argv[++i];
+        else if (arg == "--lli" && i + 1 < argc)
+            lli = argv[++i];
+        else if (arg == "--json" && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (arg == "--csv" && i + 1 < argc)
+            csvPath = argv[++i];
+        else if (arg == "--")
+            for (i++; i < argc && strcmp(argv[i], "--") != 0; i++)
+                hw5Args.push_back(argv[i]);
+        else if (arg == "-j" || arg == "--timeout" || arg == "--hw5" || arg == "--lli" || arg == "--json" ||
+                 arg == "--csv")
+        {
+            cerr << arg << " needs a value" << endl;
+            return 1;
+        }
+        else if (arg[0] == '-')
+        {
+            /* a typo isn't a directory*/
+            cerr << "unknown option " << arg << endl;
+            return 1;
+        }
+        else
+            dirs.push_back(arg);
+    }
+    if (dirs.empty())
+    {
+        cerr << "usage: test_runner [-j jobs] [--timeout seconds] [--hw5 path] [--lli path] [--json report.json] "
+                "[--csv report.csv] [-- hw5 args --] dir..."
+             << endl;
+        return 1;
+    }
+
+    vector<Test> tests;
+    for (string dir : dirs)
+    {
+        while (dir.size() > 1 && dir.back() == '/')
+            dir.pop_back();
+        vector<string> names;
+        if (!listTests(dir, names))
+        {
+            cerr << "Directory '" << dir << "' does not exist." << endl;
+            return 1;
+        }
+        for (const string &name : names)
+        {
+            tests.push_back({dir, name, {}, {}, false, false});
+        }
+    }
+    /* a gate that ran nothing didn't pass*/
+    if (tests.empty())
+    {
+        cerr << "no tests (.in files) found" << endl;
+        return 1;
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    jobs = max(1u, min<unsigned>(jobs, tests.size()));
+    atomic<size_t> next(0);
+    mutex printLock;
+    auto worker = [&]() {
+        for (size_t i = next++; i < tests.size(); i = next++)
+        {
+            runTest(tests[i], hw5, hw5Args, lli, timeout);
+            lock_guard<mutex> lock(printLock);
+            if (tests[i].passed)
+                cout << "\e[32mPassed test " << tests[i].dir << "/" << tests[i].name << "\e[0m" << endl;
+            else
+                cout << "\e[31mFailed test " << tests[i].dir << "/" << tests[i].name
+                     << (strcmp(statusOf(tests[i]), "timeout") == 0 ? " (timeout)" : "") << "\e[0m" << endl;
+        }
+    };
+    vector<thread> workers;
+    for (unsigned i = 1; i < jobs; i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (thread &t : workers)
+    {
+        t.join();
+    }
+    double wall = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t passed = 0;
+    for (const Test &test : tests)
+    {
+        passed += test.passed;
+    }
+    cout << endl
+         << "Total Passed Tests: " << passed << endl
+         << "Total Tests: " << tests.size() << endl
+         << "Wall time: " << wall * 1000 << " ms on " << jobs << " jobs" << endl;
+
+    if (!jsonPath.empty())
+    {
+        ofstream json(jsonPath);
+        writeJson(json, tests, jobs, wall);
+    }
+    if (!csvPath.empty())
+    {
+        ofstream csv(csvPath);
+        writeCsv(csv, tests);
+    }
+    return passed == tests.size() ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+#ifndef COMPI_HW5_TYPES_H
+#define COMPI_HW5_TYPES_H
+
+/**
+ * Compact id of a FanC type. Used by the AST, the symbol table and the code buffer
+ * instead of the type name, so type checks are integer compares.
+ * Only the diagnostics (output::typeToString) convert it back to text.
+ */
+enum class TypeId : unsigned char
+{
+    NONE, // no type (unknown symbol / statement without a type)
+    VOID,
+    BOOL,
+    BYTE,
+    INT,
+    STRING,
+    FUNC,
+};
+
+struct TypeInfo
+{
+    /* the LLVM type used for values of this type*/
+    const char *llvmName;
+    /* the LLVM value a declared variable of this type starts with*/
+    const char *defaultValue;
+    /* true for the types that can take part in arithmetic*/
+    bool isNumeric;
+    /* the type a value of this type is implicitly widened to (NONE if there isn't one)*/
+    TypeId widensTo;
+};
+
+/* indexed by TypeId*/
+constexpr TypeInfo TYPE_TABLE[] = {
+    /* NONE   */ {"", "", false, TypeId::NONE},
+    /* VOID   */ {"void", "", false, TypeId::NONE},
+    /* BOOL   */ {"i1", "0", false, TypeId::NONE},
+    /* BYTE   */ {"i8", "0", true, TypeId::INT},
+    /* INT    */ {"i32", "0", true, TypeId::NONE},
+    /* STRING */ {"i8*", "null", false, TypeId::NONE},
+    /* FUNC   */ {"", "", false, TypeId::NONE},
+};
+
+constexpr const TypeInfo &typeInfo(TypeId type) { return TYPE_TABLE[static_cast<int>(type)]; }
+
+constexpr const char *llvmTypeName(TypeId type) { return typeInfo(type).llvmName; }
+
+constexpr const char *typeDefaultValue(TypeId type) { return typeInfo(type).defaultValue; }
+
+constexpr bool isNumericType(TypeId type) { return typeInfo(type).isNumeric; }
+
+/* can a value of type 'from' be assigned to (or passed as) a 'to'*/
+constexpr bool isAssignable(TypeId to, TypeId from) { return to == from || (from != TypeId::NONE && typeInfo(from).widensTo == to); }
+
+/* the type of a binary arithmetic expression: the wider of the two operands*/
+constexpr TypeId widerType(TypeId left, TypeId right) { return (left == right || typeInfo(right).widensTo == left) ? left : right; }
+
+#endif